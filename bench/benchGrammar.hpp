@@ -0,0 +1,273 @@
+#pragma once
+
+#include "allocationCounter.hpp"
+#include "yaclap.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace yaclap_bench
+{
+
+    /// <summary>
+    /// Deterministic pseudo random numbers (SplitMix64), so that generated inputs are identical on all platforms and
+    /// standard libraries, unlike the distributions of <random>
+    /// </summary>
+    class Random
+    {
+    public:
+        explicit Random(uint64_t seed) noexcept
+            : m_state{seed}
+        {
+        }
+
+        uint64_t Next() noexcept
+        {
+            uint64_t z = (m_state += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return z ^ (z >> 31);
+        }
+
+        /// <summary>
+        /// Returns a number in [0, `n`)
+        /// </summary>
+        uint64_t Below(uint64_t n) noexcept
+        {
+            return Next() % n;
+        }
+
+    private:
+        uint64_t m_state;
+    };
+
+    /// <summary>
+    /// Runs `func` once more after the timed loop, and reports its heap allocations and allocated bytes as the
+    /// counters `allocs` and `alloc_bytes`
+    /// </summary>
+    template <typename F>
+    void CountAllocations(benchmark::State& state, F&& func)
+    {
+        size_t allocations = 0;
+        size_t bytes = 0;
+        {
+            yaclap_test::AllocationCounter counter;
+            func();
+            allocations = counter.Allocations();
+            bytes = counter.Bytes();
+        }
+        state.counters["allocs"] = static_cast<double>(allocations);
+        state.counters["alloc_bytes"] = static_cast<double>(bytes);
+    }
+
+    /// <summary>
+    /// Converts the ASCII string `s` to a string of `CHAR`
+    /// </summary>
+    template <typename CHAR>
+    std::basic_string<CHAR> Widen(std::string const& s)
+    {
+        return std::basic_string<CHAR>(s.cbegin(), s.cend());
+    }
+
+    /// <summary>
+    /// A command line owning its argument strings
+    /// </summary>
+    template <typename CHAR>
+    class CommandLine
+    {
+    public:
+        CommandLine()
+        {
+            Add("tool.exe");
+        }
+
+        CommandLine& Add(std::string const& arg)
+        {
+            m_args.push_back(std::make_unique<std::basic_string<CHAR>>(Widen<CHAR>(arg)));
+            m_argv.push_back(m_args.back()->c_str());
+            return *this;
+        }
+
+        inline int Argc() const noexcept
+        {
+            return static_cast<int>(m_argv.size());
+        }
+
+        inline const CHAR* const* Argv() const noexcept
+        {
+            return m_argv.data();
+        }
+
+    private:
+        // the strings are held by pointer, so that `m_argv` stays valid while adding arguments
+        std::vector<std::unique_ptr<std::basic_string<CHAR>>> m_args;
+        std::vector<const CHAR*> m_argv;
+    };
+
+    /// <summary>
+    /// A synthetic grammar of `commandCount` commands below the parser, each nested `depth` levels deep, with
+    /// `optionCount` options and switches on every level. Names and descriptions are derived from their indices.
+    /// </summary>
+    template <typename CHAR>
+    class SyntheticGrammar
+    {
+    public:
+        SyntheticGrammar(size_t commandCount, size_t depth, size_t optionCount)
+            : m_parser{Widen<CHAR>("tool.exe"), Widen<CHAR>("A synthetic grammar for benchmarks")},
+              m_depth{depth}, m_optionCount{optionCount}
+        {
+            AddOptions(m_parser, "g");
+            for (size_t c = 0; c < commandCount; ++c)
+            {
+                m_parser.Add(MakeCommand("cmd" + std::to_string(c), depth));
+            }
+            m_parser.SetErrorOnUnmatchedArguments(false);
+        }
+
+        inline yaclap::Parser<CHAR> const& GetParser() const noexcept
+        {
+            return m_parser;
+        }
+
+        inline yaclap::Parser<CHAR>& GetParser() noexcept
+        {
+            return m_parser;
+        }
+
+        /// <summary>
+        /// Generates a command line selecting a random command chain down to the deepest level, with
+        /// `optionsPerLevel` random options and switches on each level
+        /// </summary>
+        CommandLine<CHAR> MakeCommandLine(Random& rnd, size_t optionsPerLevel) const
+        {
+            CommandLine<CHAR> cmdLine;
+            AddRandomOptions(cmdLine, rnd, "g", optionsPerLevel);
+            const size_t commandCount = static_cast<size_t>(m_parser.CommandsEnd() - m_parser.CommandsBegin());
+            if (commandCount == 0)
+            {
+                return cmdLine;
+            }
+            std::string name = "cmd" + std::to_string(rnd.Below(commandCount));
+            for (size_t level = 0; level < m_depth; ++level)
+            {
+                cmdLine.Add(level == 0 ? name : "sub");
+                AddRandomOptions(cmdLine, rnd, name + "l" + std::to_string(level), optionsPerLevel);
+            }
+            return cmdLine;
+        }
+
+    private:
+        template <typename CONTAINER>
+        void AddOptions(CONTAINER& container, std::string const& prefix)
+        {
+            for (size_t i = 0; i < m_optionCount; ++i)
+            {
+                const std::string name = "--" + prefix + "-opt" + std::to_string(i);
+                container.Add(yaclap::Option<CHAR>{yaclap::Alias<CHAR>{Widen<CHAR>(name)}, Widen<CHAR>("value"),
+                                                   Widen<CHAR>("Option " + std::to_string(i) + " of " + prefix)});
+                const std::string swt = "--" + prefix + "-swt" + std::to_string(i);
+                container.Add(yaclap::Switch<CHAR>{yaclap::Alias<CHAR>{Widen<CHAR>(swt)},
+                                                   Widen<CHAR>("Switch " + std::to_string(i) + " of " + prefix)});
+            }
+        }
+
+        yaclap::Command<CHAR> MakeCommand(std::string const& name, size_t depth)
+        {
+            // all levels below the first are named `sub`, and their options are prefixed with the chain
+            yaclap::Command<CHAR> cmd{yaclap::Alias<CHAR>{Widen<CHAR>(name)}, Widen<CHAR>("Command " + name)};
+            BuildLevel(cmd, name, 0, depth);
+            return cmd;
+        }
+
+        void BuildLevel(yaclap::Command<CHAR>& cmd, std::string const& root, size_t level, size_t depth)
+        {
+            AddOptions(cmd, root + "l" + std::to_string(level));
+            if (level + 1 < depth)
+            {
+                yaclap::Command<CHAR> sub{yaclap::Alias<CHAR>{Widen<CHAR>("sub")}, Widen<CHAR>("Nested command")};
+                BuildLevel(sub, root, level + 1, depth);
+                cmd.Add(sub);
+            }
+        }
+
+        void AddRandomOptions(CommandLine<CHAR>& cmdLine, Random& rnd, std::string const& prefix, size_t count) const
+        {
+            if (m_optionCount == 0)
+            {
+                return;
+            }
+            for (size_t i = 0; i < count; ++i)
+            {
+                const std::string index = std::to_string(rnd.Below(m_optionCount));
+                if (rnd.Below(2) == 0)
+                {
+                    cmdLine.Add("--" + prefix + "-opt" + index).Add(std::to_string(rnd.Below(100000)));
+                }
+                else
+                {
+                    cmdLine.Add("--" + prefix + "-swt" + index);
+                }
+            }
+        }
+
+        yaclap::Parser<CHAR> m_parser;
+        size_t m_depth;
+        size_t m_optionCount;
+    };
+
+    /// <summary>
+    /// Generates `count` values for conversion benchmarks, `kind` being 'i' for integers in all supported notations,
+    /// 'd' for floating-point numbers, and 'b' for boolean words
+    /// </summary>
+    inline std::vector<std::string> MakeValues(Random& rnd, size_t count, char kind)
+    {
+        static const char* const bools[] = {"true", "false", "yes", "no", "on", "off", "1", "0"};
+        std::vector<std::string> values;
+        values.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            const uint64_t r = rnd.Next();
+            switch (kind)
+            {
+                case 'i':
+                    switch (r % 4)
+                    {
+                        case 0:
+                            values.push_back(std::to_string(static_cast<int64_t>(r >> 2)));
+                            break;
+                        case 1:
+                            values.push_back(std::to_string(r % 1000));
+                            break;
+                        case 2:
+                            values.push_back("-" + std::to_string((r >> 2) % 100000000));
+                            break;
+                        default:
+                        {
+                            static const char* const digits = "0123456789abcdef";
+                            std::string hex = "x";
+                            for (uint64_t v = (r >> 2) & 0xFFFFFFFFFFFFull; v != 0; v >>= 4)
+                            {
+                                hex += digits[v & 0xF];
+                            }
+                            values.push_back(hex.size() > 1 ? hex : "x0");
+                        }
+                        break;
+                    }
+                    break;
+                case 'd':
+                    values.push_back(std::to_string((r % 2000000) / 1000.0 - 1000.0) +
+                                     ((r & 0x100000) ? "e" + std::to_string(static_cast<int>(r % 40) - 20) : ""));
+                    break;
+                default:
+                    values.push_back(bools[r % 8]);
+                    break;
+            }
+        }
+        return values;
+    }
+
+} // namespace yaclap_bench
@@ -0,0 +1,55 @@
+#include "benchGrammar.hpp"
+#include "yaclap.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <sstream>
+#include <string>
+
+namespace
+{
+    /// <summary>
+    /// Renders the help of the parser of a synthetic grammar with `range(0)` commands and 20 options and 20 switches
+    /// per level. If `cached` is false, the help cache of the parser is cleared before each rendering.
+    /// </summary>
+    template <typename CHAR>
+    void RunPrintHelp(benchmark::State& state, bool cached)
+    {
+        yaclap_bench::SyntheticGrammar<CHAR> g{static_cast<size_t>(state.range(0)), 2, 20};
+        yaclap::Parser<CHAR>& parser = g.GetParser();
+        std::basic_ostringstream<CHAR> stream;
+        size_t bytes = 0;
+        auto run = [&]
+        {
+            if (!cached)
+            {
+                parser.EnableImplicitHelpSwitch(true);
+            }
+            stream.str(std::basic_string<CHAR>{});
+            parser.PrintHelp(stream);
+            bytes += static_cast<size_t>(stream.tellp()) * sizeof(CHAR);
+        };
+        for (auto _ : state)
+        {
+            run();
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(bytes));
+        yaclap_bench::CountAllocations(state, run);
+    }
+
+    template <typename CHAR>
+    void BM_PrintHelp(benchmark::State& state)
+    {
+        RunPrintHelp<CHAR>(state, false);
+    }
+    BENCHMARK_TEMPLATE(BM_PrintHelp, char)->Arg(10)->Arg(200);
+    BENCHMARK_TEMPLATE(BM_PrintHelp, wchar_t)->Arg(10)->Arg(200);
+
+    template <typename CHAR>
+    void BM_PrintHelpCached(benchmark::State& state)
+    {
+        RunPrintHelp<CHAR>(state, true);
+    }
+    BENCHMARK_TEMPLATE(BM_PrintHelpCached, char)->Arg(10)->Arg(200);
+
+} // namespace
@@ -0,0 +1,151 @@
+#include "benchGrammar.hpp"
+#include "yaclap.hpp"
+
+#ifdef _WIN32
+#include <tchar.h>
+#else
+#define _TCHAR char
+#define _T(A) A
+#endif
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using Parser = yaclap::Parser<_TCHAR>;
+    using Command = yaclap::Command<_TCHAR>;
+    using Option = yaclap::Option<_TCHAR>;
+    using Switch = yaclap::Switch<_TCHAR>;
+    using Argument = yaclap::Argument<_TCHAR>;
+
+    /// <summary>
+    /// A grammar shaped like a typical tool: a few global options, and commands with their own options and arguments
+    /// </summary>
+    struct Grammar
+    {
+        Parser parser{_T("tool.exe"), _T("desc.")};
+        Option config{_T("--config"), _T("file"), _T("desc.")};
+        Switch verbose{_T("--verbose"), _T("desc.")};
+        Command build{_T("build"), _T("desc.")};
+        Option target{_T("--target"), _T("name"), _T("desc.")};
+        Option jobs{_T("--jobs"), _T("n"), _T("desc.")};
+        Switch clean{_T("--clean"), _T("desc.")};
+        Argument project{_T("project"), _T("desc.")};
+        Command run{_T("run"), _T("desc.")};
+        Argument program{_T("program"), _T("desc.")};
+
+        Grammar()
+        {
+            verbose.AddAlias(_T("-v"));
+            jobs.AddAlias(_T("-j"));
+            build.Add(target).Add(jobs).Add(clean).Add(project);
+            run.Add(program);
+            parser.Add(config).Add(verbose).Add(build).Add(run);
+            parser.SetErrorOnUnmatchedArguments(false);
+        }
+    };
+
+    const _TCHAR* const sampleArgv[] = {_T("tool.exe"), _T("--config"), _T("tool.ini"), _T("-v"),      _T("build"),
+                                        _T("--target=release"), _T("-j"), _T("16"),       _T("--clean"), _T("app")};
+    constexpr int sampleArgc = sizeof(sampleArgv) / sizeof(_TCHAR*);
+
+    void BM_Parse(benchmark::State& state)
+    {
+        Grammar g;
+        for (auto _ : state)
+        {
+            Parser::Result res = g.parser.Parse(sampleArgc, sampleArgv);
+            benchmark::DoNotOptimize(res);
+        }
+        state.SetItemsProcessed(state.iterations());
+        yaclap_bench::CountAllocations(state, [&] { Parser::Result res = g.parser.Parse(sampleArgc, sampleArgv); });
+    }
+    BENCHMARK(BM_Parse);
+
+    void BM_ParseSession(benchmark::State& state)
+    {
+        Grammar g;
+        Parser::Session session{g.parser};
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(session.Parse(sampleArgc, sampleArgv));
+        }
+        state.SetItemsProcessed(state.iterations());
+        yaclap_bench::CountAllocations(state, [&] { session.Parse(sampleArgc, sampleArgv); });
+    }
+    BENCHMARK(BM_ParseSession);
+
+    // Scaling of ParseBatch with the number of worker threads, on a batch of 100'000 command lines
+    void BM_ParseBatch(benchmark::State& state)
+    {
+        Grammar g;
+        const std::vector<Parser::CommandLine> lines(100000, Parser::CommandLine{sampleArgc, sampleArgv});
+        const unsigned int threads = static_cast<unsigned int>(state.range(0));
+        for (auto _ : state)
+        {
+            std::vector<Parser::Result> results = g.parser.ParseBatch(lines, true, threads);
+            benchmark::DoNotOptimize(results.data());
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(lines.size()));
+        state.counters["threads"] = static_cast<double>(threads);
+    }
+    BENCHMARK(BM_ParseBatch)->RangeMultiplier(2)->Range(1, 32)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+    /// <summary>
+    /// Parses a fixed set of generated command lines in turn with a session of `parser`
+    /// </summary>
+    template <typename CHAR>
+    void RunSession(benchmark::State& state, yaclap::Parser<CHAR> const& parser,
+                    std::vector<yaclap_bench::CommandLine<CHAR>> const& lines)
+    {
+        typename yaclap::Parser<CHAR>::Session session{parser};
+        size_t i = 0;
+        for (auto _ : state)
+        {
+            yaclap_bench::CommandLine<CHAR> const& line = lines[i++ % lines.size()];
+            benchmark::DoNotOptimize(session.Parse(line.Argc(), line.Argv()));
+        }
+        state.SetItemsProcessed(state.iterations());
+        yaclap_bench::CountAllocations(state, [&] { session.Parse(lines[0].Argc(), lines[0].Argv()); });
+    }
+
+    // Wide grammars of `range(0)` commands, each with two nested levels, and 50 options and 50 switches per level
+    template <typename CHAR>
+    void BM_ParseLargeGrammar(benchmark::State& state)
+    {
+        const yaclap_bench::SyntheticGrammar<CHAR> g{static_cast<size_t>(state.range(0)), 2, 50};
+        yaclap_bench::Random rnd{0x5EED};
+        std::vector<yaclap_bench::CommandLine<CHAR>> lines;
+        for (int i = 0; i < 64; ++i)
+        {
+            lines.push_back(g.MakeCommandLine(rnd, 4));
+        }
+        RunSession(state, g.GetParser(), lines);
+    }
+    BENCHMARK_TEMPLATE(BM_ParseLargeGrammar, char)->Arg(1)->Arg(100)->Arg(500);
+    BENCHMARK_TEMPLATE(BM_ParseLargeGrammar, wchar_t)->Arg(1)->Arg(100)->Arg(500);
+
+    // Grammars of ten commands nested `range(0)` levels deep, with 10 options and 10 switches per level, parsed down
+    // to the deepest level
+    template <typename CHAR>
+    void BM_ParseDeepGrammar(benchmark::State& state)
+    {
+        const yaclap_bench::SyntheticGrammar<CHAR> g{10, static_cast<size_t>(state.range(0)), 10};
+        yaclap_bench::Random rnd{0x5EED};
+        std::vector<yaclap_bench::CommandLine<CHAR>> lines;
+        for (int i = 0; i < 64; ++i)
+        {
+            lines.push_back(g.MakeCommandLine(rnd, 1));
+        }
+        RunSession(state, g.GetParser(), lines);
+    }
+    BENCHMARK_TEMPLATE(BM_ParseDeepGrammar, char)->RangeMultiplier(4)->Range(1, 64);
+    BENCHMARK_TEMPLATE(BM_ParseDeepGrammar, wchar_t)->RangeMultiplier(4)->Range(1, 64);
+
+} // namespace
+
+BENCHMARK_MAIN();
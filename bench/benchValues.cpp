@@ -0,0 +1,110 @@
+#include "benchGrammar.hpp"
+#include "yaclap.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr size_t valueCount = 1024;
+
+    /// <summary>
+    /// One option with `valueCount` generated values of `kind`, see `yaclap_bench::MakeValues`
+    /// </summary>
+    template <typename CHAR>
+    struct ValueGrammar
+    {
+        yaclap::Parser<CHAR> parser{yaclap_bench::Widen<CHAR>("tool.exe"), yaclap_bench::Widen<CHAR>("desc.")};
+        yaclap::Option<CHAR> value{yaclap::Alias<CHAR>{yaclap_bench::Widen<CHAR>("-v")},
+                                   yaclap_bench::Widen<CHAR>("value"), yaclap_bench::Widen<CHAR>("desc.")};
+        yaclap_bench::CommandLine<CHAR> line;
+
+        explicit ValueGrammar(char kind)
+        {
+            parser.Add(value);
+            yaclap_bench::Random rnd{0x5EED};
+            for (std::string const& v : yaclap_bench::MakeValues(rnd, valueCount, kind))
+            {
+                line.Add("-v:" + v);
+            }
+        }
+    };
+
+    /// <summary>
+    /// Parses the values with a warm session, and calls `convert` for each value, unless it is nullptr.
+    /// Conversions are cached in the Result, so each iteration parses anew, and `BM_ValuesParseOnly` is the baseline
+    /// to subtract.
+    /// </summary>
+    template <typename CHAR, typename F>
+    void RunConversions(benchmark::State& state, char kind, F&& convert)
+    {
+        ValueGrammar<CHAR> g{kind};
+        typename yaclap::Parser<CHAR>::Session session{g.parser};
+        auto run = [&]
+        {
+            typename yaclap::Parser<CHAR>::Result& res = session.Parse(g.line.Argc(), g.line.Argv());
+            for (auto const& v : res.GetOptionValues(g.value))
+            {
+                convert(v);
+            }
+        };
+        for (auto _ : state)
+        {
+            run();
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(valueCount));
+        yaclap_bench::CountAllocations(state, run);
+    }
+
+    template <typename CHAR>
+    void BM_ValuesParseOnly(benchmark::State& state)
+    {
+        RunConversions<CHAR>(state, 'i', [](auto const& v) { benchmark::DoNotOptimize(v.data()); });
+    }
+    BENCHMARK_TEMPLATE(BM_ValuesParseOnly, char);
+    BENCHMARK_TEMPLATE(BM_ValuesParseOnly, wchar_t);
+
+    template <typename CHAR>
+    void BM_AsInteger(benchmark::State& state)
+    {
+        RunConversions<CHAR>(state, 'i', [](auto const& v) { benchmark::DoNotOptimize(v.AsInteger()); });
+    }
+    BENCHMARK_TEMPLATE(BM_AsInteger, char);
+    BENCHMARK_TEMPLATE(BM_AsInteger, wchar_t);
+
+    template <typename CHAR>
+    void BM_AsDouble(benchmark::State& state)
+    {
+        RunConversions<CHAR>(state, 'd', [](auto const& v) { benchmark::DoNotOptimize(v.AsDouble()); });
+    }
+    BENCHMARK_TEMPLATE(BM_AsDouble, char);
+    BENCHMARK_TEMPLATE(BM_AsDouble, wchar_t);
+
+    template <typename CHAR>
+    void BM_AsBool(benchmark::State& state)
+    {
+        RunConversions<CHAR>(state, 'b', [](auto const& v) { benchmark::DoNotOptimize(v.AsBool()); });
+    }
+    BENCHMARK_TEMPLATE(BM_AsBool, char);
+    BENCHMARK_TEMPLATE(BM_AsBool, wchar_t);
+
+    // Repeated conversions of the same values, answered from the conversion cache of the Result
+    template <typename CHAR>
+    void BM_AsIntegerCached(benchmark::State& state)
+    {
+        ValueGrammar<CHAR> g{'i'};
+        typename yaclap::Parser<CHAR>::Result res = g.parser.Parse(g.line.Argc(), g.line.Argv());
+        for (auto _ : state)
+        {
+            for (auto const& v : res.GetOptionValues(g.value))
+            {
+                benchmark::DoNotOptimize(v.AsInteger());
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(valueCount));
+    }
+    BENCHMARK_TEMPLATE(BM_AsIntegerCached, char);
+
+} // namespace
@@ -42,32 +42,286 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
+#include <bitset>
 #include <cctype>
+#include <cerrno>
+#include <charconv>
 #include <cmath>
+#include <cstdint>
 #include <cstring>
 #include <cwctype>
+#include <exception>
+#include <filesystem>
 #include <functional>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <limits>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
 #include <optional>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 #ifdef _WIN32
 #include <windows.h>
 #else
+#include <fcntl.h>
 #include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <unistd.h>
+
+extern char** environ;
+#endif
+
+// Define YACLAP_NO_SIMD to disable the use of SSE2 intrinsics
+#if !defined(YACLAP_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define YACLAP_SSE2 1
+#include <emmintrin.h>
 #endif
 
 namespace yaclap
 {
 
+#ifdef YACLAP_SSE2
+    /// <summary>
+    /// SSE2 operations on 128 bit vectors of characters, i.e. 16, 8, or 4 lanes depending on the size of CHAR
+    /// </summary>
+    template <typename CHAR>
+    struct Sse2
+    {
+        static constexpr size_t lanes = 16 / sizeof(CHAR);
+
+        static inline __m128i Load(const CHAR* p) noexcept
+        {
+            return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        }
+
+        static inline __m128i Set(int v) noexcept
+        {
+            if constexpr (sizeof(CHAR) == 1)
+            {
+                return _mm_set1_epi8(static_cast<char>(v));
+            }
+            else if constexpr (sizeof(CHAR) == 2)
+            {
+                return _mm_set1_epi16(static_cast<short>(v));
+            }
+            else
+            {
+                return _mm_set1_epi32(v);
+            }
+        }
+
+        static inline __m128i Greater(__m128i a, __m128i b) noexcept
+        {
+            if constexpr (sizeof(CHAR) == 1)
+            {
+                return _mm_cmpgt_epi8(a, b);
+            }
+            else if constexpr (sizeof(CHAR) == 2)
+            {
+                return _mm_cmpgt_epi16(a, b);
+            }
+            else
+            {
+                return _mm_cmpgt_epi32(a, b);
+            }
+        }
+
+        static inline __m128i Equal(__m128i a, __m128i b) noexcept
+        {
+            if constexpr (sizeof(CHAR) == 1)
+            {
+                return _mm_cmpeq_epi8(a, b);
+            }
+            else if constexpr (sizeof(CHAR) == 2)
+            {
+                return _mm_cmpeq_epi16(a, b);
+            }
+            else
+            {
+                return _mm_cmpeq_epi32(a, b);
+            }
+        }
+
+        static inline bool AllEqual(__m128i a, __m128i b) noexcept
+        {
+            return _mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) == 0xFFFF;
+        }
+
+        /// <summary>
+        /// Returns the index of the first lane set in `mask`, or `lanes` if no lane is set
+        /// </summary>
+        static inline size_t FirstLane(__m128i mask) noexcept
+        {
+            const unsigned int bits = static_cast<unsigned int>(_mm_movemask_epi8(mask));
+            if (bits == 0)
+            {
+                return lanes;
+            }
+#ifdef _MSC_VER
+            unsigned long index;
+            _BitScanForward(&index, bits);
+            return static_cast<size_t>(index) / sizeof(CHAR);
+#else
+            return static_cast<size_t>(__builtin_ctz(bits)) / sizeof(CHAR);
+#endif
+        }
+    };
+#endif
+
+    /// <summary>
+    /// Reference to a string with static storage duration, usually a string literal.
+    /// Names and descriptions constructed from a Literal only reference the string and do not copy it, so defining a
+    /// grammar from literals does not allocate heap memory for its texts.
+    /// </summary>
+    template <typename CHAR>
+    class Literal
+    {
+    public:
+        template <size_t N>
+        constexpr Literal(const CHAR (&str)[N]) noexcept
+            : m_view{str, N - 1}
+        {
+        }
+
+        constexpr explicit Literal(const CHAR* str) noexcept
+            : m_view{str}
+        {
+        }
+
+        constexpr explicit Literal(std::basic_string_view<CHAR> str) noexcept
+            : m_view{str}
+        {
+        }
+
+        constexpr std::basic_string_view<CHAR> GetView() const noexcept
+        {
+            return m_view;
+        }
+
+    private:
+        std::basic_string_view<CHAR> m_view;
+    };
+
+    namespace literals
+    {
+        constexpr Literal<char> operator""_lit(const char* str, size_t len) noexcept
+        {
+            return Literal<char>{std::basic_string_view<char>{str, len}};
+        }
+
+        constexpr Literal<wchar_t> operator""_lit(const wchar_t* str, size_t len) noexcept
+        {
+            return Literal<wchar_t>{std::basic_string_view<wchar_t>{str, len}};
+        }
+    } // namespace literals
+
+    /// <summary>
+    /// Storage of a name or description text, either referencing a `Literal` or owning a copy of any other string
+    /// </summary>
+    template <typename CHAR>
+    class StringStorage
+    {
+    public:
+        StringStorage() noexcept = default;
+
+        constexpr StringStorage(const Literal<CHAR>& str) noexcept
+            : m_view{str.GetView()}
+        {
+        }
+
+        template <typename TSTR>
+        StringStorage(const TSTR& str)
+            : m_owned{str}, m_view{m_owned}, m_isOwned{true}
+        {
+        }
+
+        StringStorage(const StringStorage& src)
+            : m_owned{src.m_owned}, m_view{src.m_isOwned ? m_owned : src.m_view}, m_isOwned{src.m_isOwned}
+        {
+        }
+
+        StringStorage(StringStorage&& src) noexcept
+            : m_owned{std::move(src.m_owned)}, m_view{src.m_isOwned ? m_owned : src.m_view}, m_isOwned{src.m_isOwned}
+        {
+            src.ResetMovedFrom();
+        }
+
+        StringStorage& operator=(const StringStorage& src)
+        {
+            if (this != &src)
+            {
+                m_owned = src.m_owned;
+                m_isOwned = src.m_isOwned;
+                m_view = m_isOwned ? std::basic_string_view<CHAR>{m_owned} : src.m_view;
+            }
+            return *this;
+        }
+
+        StringStorage& operator=(StringStorage&& src) noexcept
+        {
+            if (this != &src)
+            {
+                m_owned = std::move(src.m_owned);
+                m_isOwned = src.m_isOwned;
+                m_view = m_isOwned ? std::basic_string_view<CHAR>{m_owned} : src.m_view;
+                src.ResetMovedFrom();
+            }
+            return *this;
+        }
+
+        inline std::basic_string_view<CHAR> View() const noexcept
+        {
+            return m_view;
+        }
+
+        /// <summary>
+        /// Returns the text as string. For a referenced `Literal`, the first call copies the text into this object,
+        /// which is not safe against concurrent calls, so prefer `View`.
+        /// </summary>
+        inline const std::basic_string<CHAR>& String() const
+        {
+            if (!m_isOwned && m_owned.size() != m_view.size())
+            {
+                m_owned.assign(m_view);
+            }
+            return m_owned;
+        }
+
+        /// <summary>
+        /// Returns true if the text is a copy owned by this object, and false if it references a `Literal`
+        /// </summary>
+        inline bool IsOwned() const noexcept
+        {
+            return m_isOwned;
+        }
+
+    private:
+        // for a referenced Literal, only filled by `String`
+        mutable std::basic_string<CHAR> m_owned;
+        std::basic_string_view<CHAR> m_view;
+        bool m_isOwned{false};
+
+        void ResetMovedFrom() noexcept
+        {
+            if (m_isOwned)
+            {
+                m_owned.clear();
+                m_view = m_owned;
+            }
+        }
+    };
+
     template <typename CHAR>
     class Alias
     {
@@ -83,23 +337,44 @@ namespace yaclap
         Alias(const CHAR* name, StringCompare stringCompare = StringCompare::CaseSensitive)
             : m_name{name}, m_stringCompare{stringCompare}
         {
+            InitFoldedName();
+        }
+
+        /// <summary>
+        /// Creates an alias referencing the literal `name` without copying it.
+        /// A case-insensitive alias only allocates memory if its name is not already in folded case.
+        /// </summary>
+        Alias(const Literal<CHAR>& name, StringCompare stringCompare = StringCompare::CaseSensitive)
+            : m_name{name}, m_stringCompare{stringCompare}
+        {
+            InitFoldedName();
         }
 
         template <typename T, typename A>
         Alias(const std::basic_string<CHAR, T, A>& name, StringCompare stringCompare = StringCompare::CaseSensitive)
             : m_name{name}, m_stringCompare{stringCompare}
         {
+            InitFoldedName();
         }
 
         template <typename T>
         Alias(const std::basic_string_view<CHAR, T>& name, StringCompare stringCompare = StringCompare::CaseSensitive)
             : m_name{name}, m_stringCompare{stringCompare}
         {
+            InitFoldedName();
         }
 
-        const std::basic_string<CHAR>& GetName() const noexcept
+        /// <summary>
+        /// Returns the name. For names referencing a `Literal`, the first call copies the name, see `GetNameView`.
+        /// </summary>
+        inline const std::basic_string<CHAR>& GetName() const
+        {
+            return m_name.String();
+        }
+
+        inline std::basic_string_view<CHAR> GetNameView() const noexcept
         {
-            return m_name;
+            return m_name.View();
         }
 
         StringCompare GetStringCompareMode() const noexcept
@@ -110,50 +385,134 @@ namespace yaclap
         template <typename T>
         bool IsMatch(const std::basic_string_view<CHAR, T>& s) const
         {
-            if (s.size() != m_name.size())
+            const std::basic_string_view<CHAR> name = m_name.View();
+            if (s.size() != name.size())
+            {
+                return false;
+            }
+
+            if (m_stringCompare == StringCompare::CaseInsensitive)
+            {
+                return EqualsFolded(s.data(), FoldedName(), s.size());
+            }
+
+            return std::char_traits<CHAR>::compare(s.data(), name.data(), s.size()) == 0;
+        }
+
+        /// <summary>
+        /// Returns true if `s` is a prefix of the name, respecting the string compare mode
+        /// </summary>
+        template <typename T>
+        bool IsPrefix(const std::basic_string_view<CHAR, T>& s) const
+        {
+            const std::basic_string_view<CHAR> name = m_name.View();
+            if (s.size() > name.size())
             {
                 return false;
             }
 
             if (m_stringCompare == StringCompare::CaseInsensitive)
             {
-                for (size_t i = 0; i < s.size(); ++i)
+                return EqualsFolded(s.data(), FoldedName(), s.size());
+            }
+
+            return std::char_traits<CHAR>::compare(s.data(), name.data(), s.size()) == 0;
+        }
+
+        /// <summary>
+        /// Folds the case of a single character, as used when matching with `StringCompare::CaseInsensitive`.
+        /// ASCII characters are folded directly, all others through the locale-dependent `tolower`/`towlower`.
+        /// </summary>
+        static inline CHAR FoldCase(CHAR c)
+        {
+            if (static_cast<std::make_unsigned_t<CHAR>>(c) < 0x80)
+            {
+                return (c >= static_cast<CHAR>('A') && c <= static_cast<CHAR>('Z')) ? static_cast<CHAR>(c + 0x20) : c;
+            }
+            return FoldCaseNonAscii(c);
+        }
+
+    private:
+        StringStorage<CHAR> m_name;
+        // only set if folding the case changes the name
+        std::basic_string<CHAR> m_foldedName;
+        StringCompare m_stringCompare;
+
+        static inline CHAR FoldCaseNonAscii(CHAR c);
+
+        void InitFoldedName()
+        {
+            if (m_stringCompare != StringCompare::CaseInsensitive)
+            {
+                return;
+            }
+            const std::basic_string_view<CHAR> name = m_name.View();
+            if (std::all_of(name.cbegin(), name.cend(), [](CHAR c) { return FoldCase(c) == c; }))
+            {
+                return;
+            }
+            m_foldedName.resize(name.size());
+            std::transform(name.cbegin(), name.cend(), m_foldedName.begin(), FoldCase);
+        }
+
+        inline const CHAR* FoldedName() const noexcept
+        {
+            return m_foldedName.empty() ? m_name.View().data() : m_foldedName.data();
+        }
+
+        /// <summary>
+        /// Compares `len` characters of `s`, case-folded, with the already case-folded `folded`
+        /// </summary>
+        static bool EqualsFolded(const CHAR* s, const CHAR* folded, size_t len)
+        {
+            size_t i = 0;
+#ifdef YACLAP_SSE2
+            constexpr size_t lanes = Sse2<CHAR>::lanes;
+            for (; i + lanes <= len; i += lanes)
+            {
+                const __m128i v = Sse2<CHAR>::Load(s + i);
+                const __m128i f = Sse2<CHAR>::Load(folded + i);
+                if (Sse2<CHAR>::AllEqual(_mm_and_si128(v, Sse2<CHAR>::Set(~0x7F)), _mm_setzero_si128()))
                 {
-                    if (!AreCharEqualCaseInsenstive(m_name[i], s[i]))
+                    // all lanes are ASCII: add 0x20 to all lanes in 'A'..'Z'
+                    const __m128i upper = _mm_and_si128(Sse2<CHAR>::Greater(v, Sse2<CHAR>::Set('A' - 1)),
+                                                        Sse2<CHAR>::Greater(Sse2<CHAR>::Set('Z' + 1), v));
+                    if (!Sse2<CHAR>::AllEqual(_mm_or_si128(v, _mm_and_si128(upper, Sse2<CHAR>::Set(0x20))), f))
+                    {
+                        return false;
+                    }
+                    continue;
+                }
+                for (size_t j = i; j < i + lanes; ++j)
+                {
+                    if (FoldCase(s[j]) != folded[j])
                     {
                         return false;
                     }
                 }
-                return true;
             }
-
-            for (size_t i = 0; i < s.size(); ++i)
+#endif
+            for (; i < len; ++i)
             {
-                if (m_name[i] != s[i])
+                if (FoldCase(s[i]) != folded[i])
                 {
                     return false;
                 }
             }
             return true;
         }
-
-    private:
-        std::basic_string<CHAR> m_name;
-        StringCompare m_stringCompare;
-
-        static inline bool AreCharEqualCaseInsenstive(CHAR const& a, CHAR const& b);
     };
 
     template <>
-    inline bool Alias<char>::AreCharEqualCaseInsenstive(char const& a, char const& b)
+    inline char Alias<char>::FoldCaseNonAscii(char c)
     {
-        return std::tolower(a) == std::tolower(b);
+        return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
     }
 
     template <>
-    inline bool Alias<wchar_t>::AreCharEqualCaseInsenstive(wchar_t const& a, wchar_t const& b)
+    inline wchar_t Alias<wchar_t>::FoldCaseNonAscii(wchar_t c)
     {
-        return std::towlower(a) == std::towlower(b);
+        return static_cast<wchar_t>(std::towlower(c));
     }
 
     template <typename CHAR>
@@ -169,11 +528,21 @@ namespace yaclap
 
         void AddAliasImpl(const Alias<CHAR>& alias)
         {
-            if (alias.GetName().empty())
+            if (alias.GetNameView().empty())
             {
                 throw std::invalid_argument("alias");
             }
-            m_names.push_back(alias);
+            if (!m_hasFirstName)
+            {
+                m_firstName = alias;
+                m_hasFirstName = true;
+                return;
+            }
+            if (m_moreNames.empty())
+            {
+                m_moreNames.push_back(m_firstName);
+            }
+            m_moreNames.push_back(alias);
         }
 
         void SetHideFromHelpImpl() noexcept
@@ -182,14 +551,15 @@ namespace yaclap
         }
 
     public:
-        inline typename std::vector<Alias<CHAR>>::const_iterator NameAliasBegin() const
+        inline const Alias<CHAR>* NameAliasBegin() const noexcept
         {
-            return m_names.cbegin();
+            return m_moreNames.empty() ? &m_firstName : m_moreNames.data();
         }
 
-        inline typename std::vector<Alias<CHAR>>::const_iterator NameAliasEnd() const
+        inline const Alias<CHAR>* NameAliasEnd() const noexcept
         {
-            return m_names.cend();
+            return m_moreNames.empty() ? (&m_firstName + (m_hasFirstName ? 1 : 0))
+                                       : (m_moreNames.data() + m_moreNames.size());
         }
 
         std::basic_string<CHAR> GetAllNames() const;
@@ -197,9 +567,9 @@ namespace yaclap
         template <typename T>
         bool IsMatch(const std::basic_string_view<CHAR, T>& s) const
         {
-            for (Alias<CHAR> const& a : m_names)
+            for (const Alias<CHAR>* a = NameAliasBegin(); a != NameAliasEnd(); ++a)
             {
-                if (a.IsMatch(s))
+                if (a->IsMatch(s))
                 {
                     return true;
                 }
@@ -213,64 +583,311 @@ namespace yaclap
         }
 
     private:
-        std::vector<Alias<CHAR>> m_names;
+        // The first name is stored inline, so that items with a single name do not allocate.
+        // Once an alias is added, all names, including the first one, are stored in `m_moreNames`.
+        Alias<CHAR> m_firstName;
+        std::vector<Alias<CHAR>> m_moreNames;
+        bool m_hasFirstName{false};
         bool m_hideFromHelp{false};
     };
 
+    /// <summary>
+    /// Hash index over the names and aliases of the Commands, Options, and Switches of one container.
+    /// Case-sensitive aliases are keyed by the hash of their name, case-insensitive aliases by the hash of their
+    /// case-folded name. Every candidate of a probe is verified with `IsMatch`, so hash collisions never match.
+    /// </summary>
     template <typename CHAR>
-    class WithName
+    class NameIndex
     {
-    protected:
-        WithName() noexcept = default;
-
-        template <typename TSTR>
-        WithName(const TSTR& name)
-            : m_name{name}
+    public:
+        enum class Kind : uint8_t
         {
-        }
+            Command,
+            Option,
+            Switch
+        };
 
-    public:
-        inline const std::basic_string<CHAR>& GetName() const noexcept
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+        /// <summary>
+        /// The hashes of one input string, computed once and then used to probe the indices of all active scopes
+        /// </summary>
+        class Key
         {
-            return m_name;
-        }
+        public:
+            explicit Key(std::basic_string_view<CHAR> str) noexcept
+                : m_str{str}, m_hash{Hash(str, false)}, m_foldedHash{Hash(str, true)}
+            {
+            }
 
-    private:
-        std::basic_string<CHAR> m_name;
-    };
+            inline std::basic_string_view<CHAR> const& GetString() const noexcept
+            {
+                return m_str;
+            }
 
-    template <typename CHAR>
-    class WithDescription
-    {
-    protected:
-        WithDescription() noexcept = default;
+            inline size_t GetHash() const noexcept
+            {
+                return m_hash;
+            }
 
-        template <typename TSTR>
-        WithDescription(const TSTR& description)
-            : m_desc{description}
+            inline size_t GetFoldedHash() const noexcept
+            {
+                return m_foldedHash;
+            }
+
+        private:
+            std::basic_string_view<CHAR> m_str;
+            size_t m_hash;
+            size_t m_foldedHash;
+        };
+
+        void Add(Kind kind, size_t index, WithNameAndAlias<CHAR> const& named)
         {
+            for (auto a = named.NameAliasBegin(); a != named.NameAliasEnd(); ++a)
+            {
+                const bool fold = a->GetStringCompareMode() == Alias<CHAR>::StringCompare::CaseInsensitive;
+                m_entries.emplace(Hash(a->GetNameView(), fold), Entry{kind, index});
+            }
         }
 
-    public:
-        inline const std::basic_string<CHAR>& GetDescription() const noexcept
+        /// <summary>
+        /// Returns the smallest index of an element of `kind` for which `isMatch(index)` confirms the match, or `npos`
+        /// </summary>
+        template <typename ISMATCH>
+        size_t Find(Key const& key, Kind kind, ISMATCH const& isMatch) const
         {
-            return m_desc;
+            size_t found = npos;
+            auto probe = [&](size_t hash)
+            {
+                auto range = m_entries.equal_range(hash);
+                for (auto it = range.first; it != range.second; ++it)
+                {
+                    if (it->second.kind == kind && it->second.index < found && isMatch(it->second.index))
+                    {
+                        found = it->second.index;
+                    }
+                }
+            };
+            probe(key.GetHash());
+            if (key.GetFoldedHash() != key.GetHash())
+            {
+                probe(key.GetFoldedHash());
+            }
+            return found;
         }
 
     private:
-        std::basic_string<CHAR> m_desc;
-    };
+        struct Entry
+        {
+            Kind kind;
+            size_t index;
+        };
+
+        static size_t Hash(std::basic_string_view<CHAR> str, bool fold) noexcept
+        {
+            // FNV-1a
+            uint64_t h = 14695981039346656037ull;
+            for (CHAR c : str)
+            {
+                const CHAR k = fold ? Alias<CHAR>::FoldCase(c) : c;
+                h ^= static_cast<uint64_t>(static_cast<std::make_unsigned_t<CHAR>>(k));
+                h *= 1099511628211ull;
+            }
+            return static_cast<size_t>(h);
+        }
+
+        std::unordered_multimap<size_t, Entry> m_entries;
+    };
+
+    template <typename CHAR>
+    class WithName
+    {
+    protected:
+        WithName() noexcept = default;
+
+        template <typename TSTR>
+        WithName(const TSTR& name)
+            : m_name{name}
+        {
+        }
+
+    public:
+        /// <summary>
+        /// Returns the name. For names referencing a `Literal`, the first call copies the name, see `GetNameView`.
+        /// </summary>
+        inline const std::basic_string<CHAR>& GetName() const
+        {
+            return m_name.String();
+        }
+
+        inline std::basic_string_view<CHAR> GetNameView() const noexcept
+        {
+            return m_name.View();
+        }
+
+    private:
+        StringStorage<CHAR> m_name;
+    };
+
+    template <typename CHAR>
+    class WithDescription
+    {
+    protected:
+        WithDescription() noexcept = default;
+
+        template <typename TSTR>
+        WithDescription(const TSTR& description)
+            : m_desc{description}
+        {
+        }
+
+    public:
+        /// <summary>
+        /// Returns the description. For descriptions referencing a `Literal`, the first call copies the description,
+        /// see `GetDescriptionView`.
+        /// </summary>
+        inline const std::basic_string<CHAR>& GetDescription() const
+        {
+            return m_desc.String();
+        }
+
+        inline std::basic_string_view<CHAR> GetDescriptionView() const noexcept
+        {
+            return m_desc.View();
+        }
+
+    private:
+        StringStorage<CHAR> m_desc;
+    };
+
+    template <typename CHAR>
+    class Parser;
+
+    /// <summary>
+    /// Target to which `Parser::Parse` stores the values of an Option, Switch, or Argument while parsing, either a
+    /// variable or a setter function.
+    /// Values are converted like with `Parser::ResultValueView::As`, and conversion errors are reported to the parse
+    /// Result. Bound targets are written by every parse, so a grammar with bindings must not be used by concurrent
+    /// parses, e.g. `ParseBatch`.
+    /// </summary>
+    template <typename CHAR>
+    class WithBinding
+    {
+    protected:
+        /// <summary>
+        /// Stores the value of the Parser::ResultValueView `view` to `target`, returns false if it cannot be converted
+        /// </summary>
+        using StoreFunc = bool (*)(void* target, const void* view);
+
+        WithBinding() noexcept = default;
+
+        void SetBindingImpl(void* target, StoreFunc store, std::shared_ptr<void> setter = nullptr) noexcept
+        {
+            m_target = target;
+            m_store = store;
+            m_setter = std::move(setter);
+        }
+
+        template <typename SIGNATURE, typename F>
+        void SetSetterImpl(F&& setter, StoreFunc store)
+        {
+            auto func = std::make_shared<std::function<SIGNATURE>>(std::forward<F>(setter));
+            void* target = func.get();
+            SetBindingImpl(target, store, std::move(func));
+        }
+
+        template <typename T>
+        static bool StoreValue(void* target, const void* view)
+        {
+            std::optional<T> v = static_cast<typename Parser<CHAR>::ResultValueView const*>(view)->template As<T>();
+            if (!v.has_value())
+            {
+                return false;
+            }
+            *static_cast<T*>(target) = std::move(v.value());
+            return true;
+        }
+
+        template <typename T>
+        static bool StoreValueToSetter(void* setter, const void* view)
+        {
+            std::optional<T> v = static_cast<typename Parser<CHAR>::ResultValueView const*>(view)->template As<T>();
+            if (!v.has_value())
+            {
+                return false;
+            }
+            (*static_cast<std::function<void(T)>*>(setter))(std::move(v.value()));
+            return true;
+        }
+
+    public:
+        inline bool IsBound() const noexcept
+        {
+            return m_store != nullptr;
+        }
+
+    private:
+        friend class Parser<CHAR>;
+
+        /// <summary>
+        /// Stores the value of `view`, pointing to a Parser::ResultValueView, or nullptr for Switches, to the bound
+        /// target. Returns false if the value could not be converted.
+        /// </summary>
+        inline bool StoreBound(const void* view) const
+        {
+            return m_store(m_target, view);
+        }
+
+        void* m_target{nullptr};
+        StoreFunc m_store{nullptr};
+        std::shared_ptr<void> m_setter;
+    };
+
+    /// <summary>
+    /// Name of the environment variable which supplies the value of an Option or Switch missing from the command line
+    /// </summary>
+    template <typename CHAR>
+    class WithEnvironmentVariable
+    {
+    protected:
+        WithEnvironmentVariable() noexcept = default;
+
+        template <typename TSTR>
+        void SetEnvironmentNameImpl(const TSTR& name)
+        {
+            m_envName = StringStorage<CHAR>{name};
+        }
+
+    public:
+        inline std::basic_string_view<CHAR> GetEnvironmentName() const noexcept
+        {
+            return m_envName.View();
+        }
+
+        inline bool HasEnvironmentName() const noexcept
+        {
+            return !m_envName.View().empty();
+        }
+
+    private:
+        StringStorage<CHAR> m_envName;
+    };
 
     template <typename CHAR>
     class WithIdentity
     {
     private:
-        static uint32_t c_nextId;
+        static std::atomic<uint32_t> c_nextId;
         uint32_t m_id = 0;
 
+        static inline uint32_t NextId() noexcept
+        {
+            return c_nextId.fetch_add(1, std::memory_order_relaxed);
+        }
+
     public:
         WithIdentity() noexcept
-            : m_id{c_nextId++}
+            : m_id{NextId()}
         {
         }
 
@@ -282,7 +899,7 @@ namespace yaclap
         WithIdentity(WithIdentity&& src) noexcept
             : m_id{src.m_id}
         {
-            src.m_id = c_nextId++;
+            src.m_id = NextId();
         }
 
         WithIdentity& operator=(const WithIdentity& src) noexcept
@@ -294,7 +911,7 @@ namespace yaclap
         WithIdentity& operator=(WithIdentity&& src) noexcept
         {
             m_id = src.m_id;
-            src.m_id = c_nextId++;
+            src.m_id = NextId();
             return *this;
         }
 
@@ -311,10 +928,13 @@ namespace yaclap
     };
 
     template <typename CHAR>
-    uint32_t WithIdentity<CHAR>::c_nextId = 1;
+    std::atomic<uint32_t> WithIdentity<CHAR>::c_nextId{1};
 
     template <typename CHAR>
-    class Argument : public WithIdentity<CHAR>, public WithName<CHAR>, public WithDescription<CHAR>
+    class Argument : public WithIdentity<CHAR>,
+                     public WithName<CHAR>,
+                     public WithDescription<CHAR>,
+                     public WithBinding<CHAR>
     {
     public:
         static constexpr bool NotRequired = false;
@@ -332,12 +952,38 @@ namespace yaclap
             return m_isRequired;
         }
 
+        /// <summary>
+        /// Binds the value to the variable `target`, to which `Parser::Parse` stores the converted value while
+        /// parsing. If the Argument is matched multiple times, the last value is stored.
+        /// </summary>
+        template <typename T>
+        Argument& Bind(T* target)
+        {
+            WithBinding<CHAR>::SetBindingImpl(target, &WithBinding<CHAR>::template StoreValue<T>);
+            return *this;
+        }
+
+        /// <summary>
+        /// Binds the value to the function `setter`, which `Parser::Parse` calls with the value converted to `T`
+        /// </summary>
+        template <typename T, typename F, std::enable_if_t<std::is_invocable_v<F, T>, int> = 0>
+        Argument& Bind(F&& setter)
+        {
+            WithBinding<CHAR>::template SetSetterImpl<void(T)>(std::forward<F>(setter),
+                                                               &WithBinding<CHAR>::template StoreValueToSetter<T>);
+            return *this;
+        }
+
     private:
         bool m_isRequired;
     };
 
     template <typename CHAR>
-    class Option : public WithIdentity<CHAR>, public WithNameAndAlias<CHAR>, public WithDescription<CHAR>
+    class Option : public WithIdentity<CHAR>,
+                   public WithNameAndAlias<CHAR>,
+                   public WithDescription<CHAR>,
+                   public WithBinding<CHAR>,
+                   public WithEnvironmentVariable<CHAR>
     {
     public:
         Option() noexcept = default;
@@ -360,28 +1006,70 @@ namespace yaclap
             return *this;
         }
 
-        inline const std::basic_string<CHAR>& GetArgumentName() const noexcept
+        /// <summary>
+        /// Takes the value of the Option from the environment variable `name`, if the Option is missing from the
+        /// command line. See `Parser::SetEnvironment`.
+        /// </summary>
+        template <typename TSTR>
+        Option& FromEnvironment(const TSTR& name)
+        {
+            WithEnvironmentVariable<CHAR>::SetEnvironmentNameImpl(name);
+            return *this;
+        }
+
+        /// <summary>
+        /// Binds the value to the variable `target`, to which `Parser::Parse` stores the converted value while
+        /// parsing. If the Option is present multiple times, the last value is stored.
+        /// </summary>
+        template <typename T>
+        Option& Bind(T* target)
+        {
+            WithBinding<CHAR>::SetBindingImpl(target, &WithBinding<CHAR>::template StoreValue<T>);
+            return *this;
+        }
+
+        /// <summary>
+        /// Binds the value to the function `setter`, which `Parser::Parse` calls with the value converted to `T`
+        /// </summary>
+        template <typename T, typename F, std::enable_if_t<std::is_invocable_v<F, T>, int> = 0>
+        Option& Bind(F&& setter)
+        {
+            WithBinding<CHAR>::template SetSetterImpl<void(T)>(std::forward<F>(setter),
+                                                               &WithBinding<CHAR>::template StoreValueToSetter<T>);
+            return *this;
+        }
+
+        /// <summary>
+        /// Returns the argument name. For argument names referencing a `Literal`, the first call copies the name, see
+        /// `GetArgumentNameView`.
+        /// </summary>
+        inline const std::basic_string<CHAR>& GetArgumentName() const
+        {
+            return m_argName.String();
+        }
+
+        inline std::basic_string_view<CHAR> GetArgumentNameView() const noexcept
         {
-            return m_argName;
+            return m_argName.View();
         }
 
         template <typename T1, typename T2>
         bool IsMatchWithValue(const std::basic_string_view<CHAR, T1>& s,
                               std::basic_string_view<CHAR, T2>& outValueStr) const
         {
-            for (typename std::vector<Alias<CHAR>>::const_iterator a = WithNameAndAlias<CHAR>::NameAliasBegin();
+            for (const Alias<CHAR>* a = WithNameAndAlias<CHAR>::NameAliasBegin();
                  a != WithNameAndAlias<CHAR>::NameAliasEnd(); ++a)
             {
-                size_t nameLen = a->GetName().size();
+                size_t nameLen = a->GetNameView().size();
                 if (nameLen >= s.size())
                 {
-                    return false;
+                    continue;
                 }
                 // If option name and value were quoted together, being one arg string, e.g. ` \"-do something\" `,
                 // then the space char is interpreted as separator, making the input the same as `"-do" "something"`.
                 if (s[nameLen] != ':' && s[nameLen] != ' ' && s[nameLen] != '=')
                 {
-                    return false;
+                    continue;
                 }
                 std::basic_string_view<CHAR> sub{s.data(), nameLen};
 
@@ -396,11 +1084,15 @@ namespace yaclap
         }
 
     private:
-        std::basic_string<CHAR> m_argName;
+        StringStorage<CHAR> m_argName;
     };
 
     template <typename CHAR>
-    class Switch : public WithIdentity<CHAR>, public WithNameAndAlias<CHAR>, public WithDescription<CHAR>
+    class Switch : public WithIdentity<CHAR>,
+                   public WithNameAndAlias<CHAR>,
+                   public WithDescription<CHAR>,
+                   public WithBinding<CHAR>,
+                   public WithEnvironmentVariable<CHAR>
     {
     public:
         Switch() noexcept = default;
@@ -422,11 +1114,73 @@ namespace yaclap
             WithNameAndAlias<CHAR>::SetHideFromHelpImpl();
             return *this;
         }
+
+        /// <summary>
+        /// Takes the state of the Switch from the environment variable `name`, if the Switch is missing from the
+        /// command line. See `Parser::SetEnvironment`. The value is converted like with
+        /// `Parser::ResultValueView::AsBool`, and if it is true, the Switch counts as present once.
+        /// </summary>
+        template <typename TSTR>
+        Switch& FromEnvironment(const TSTR& name)
+        {
+            WithEnvironmentVariable<CHAR>::SetEnvironmentNameImpl(name);
+            return *this;
+        }
+
+        /// <summary>
+        /// Binds the switch to the variable `target`, which `Parser::Parse` sets while parsing.
+        /// A `bool` variable is set to true if the Switch is present, an integer variable is incremented for each
+        /// occurrence of the Switch.
+        /// </summary>
+        template <typename T>
+        Switch& Bind(T* target)
+        {
+            static_assert(std::is_integral_v<T>, "switches can only be bound to bool or integer variables");
+            WithBinding<CHAR>::SetBindingImpl(target, &StoreSwitch<T>);
+            return *this;
+        }
+
+        /// <summary>
+        /// Binds the switch to the function `setter`, which `Parser::Parse` calls for each occurrence of the Switch
+        /// </summary>
+        template <typename F, std::enable_if_t<std::is_invocable_v<F>, int> = 0>
+        Switch& Bind(F&& setter)
+        {
+            WithBinding<CHAR>::template SetSetterImpl<void()>(std::forward<F>(setter), &CallSwitchSetter);
+            return *this;
+        }
+
+    private:
+        template <typename T>
+        static bool StoreSwitch(void* target, const void*)
+        {
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                *static_cast<bool*>(target) = true;
+            }
+            else
+            {
+                ++*static_cast<T*>(target);
+            }
+            return true;
+        }
+
+        static bool CallSwitchSetter(void* setter, const void*)
+        {
+            (*static_cast<std::function<void()>*>(setter))();
+            return true;
+        }
     };
 
     template <typename CHAR>
     class Command;
 
+    /// <summary>
+    /// Holds the sub-Commands, Options, Switches, and Arguments.
+    /// The contents are shared between copies, and are only copied when a copy is changed. Adding a Command with a
+    /// large subtree to a parent therefore does not copy the subtree, and the same Command added to several parents
+    /// shares one subtree.
+    /// </summary>
     template <typename CHAR>
     class WithCommandContainer
     {
@@ -441,7 +1195,10 @@ namespace yaclap
             {
                 throw std::invalid_argument("option");
             }
-            m_options.push_back(option);
+            Contents& c = MutableContents();
+            c.nameIndex.Add(NameIndex<CHAR>::Kind::Option, c.options.size(), option);
+            c.options.push_back(option);
+            c.withEnvironment = c.withEnvironment || option.HasEnvironmentName();
         }
 
         void AddSwitchImpl(const Switch<CHAR>& switchOption)
@@ -450,60 +1207,134 @@ namespace yaclap
             {
                 throw std::invalid_argument("switchOption");
             }
-            m_switches.push_back(switchOption);
+            Contents& c = MutableContents();
+            c.nameIndex.Add(NameIndex<CHAR>::Kind::Switch, c.switches.size(), switchOption);
+            c.switches.push_back(switchOption);
+            c.withEnvironment = c.withEnvironment || switchOption.HasEnvironmentName();
         }
 
         void AddArgumentImpl(const Argument<CHAR>& argument)
         {
-            m_arguments.push_back(argument);
+            MutableContents().arguments.push_back(argument);
         }
 
     public:
         inline typename std::vector<Command<CHAR>>::const_iterator CommandsBegin() const
         {
-            return m_commands.cbegin();
+            return GetContents().commands.cbegin();
         }
 
         inline typename std::vector<Command<CHAR>>::const_iterator CommandsEnd() const
         {
-            return m_commands.cend();
+            return GetContents().commands.cend();
         }
 
         inline typename std::vector<Option<CHAR>>::const_iterator OptionsBegin() const
         {
-            return m_options.cbegin();
+            return GetContents().options.cbegin();
         }
 
         inline typename std::vector<Option<CHAR>>::const_iterator OptionsEnd() const
         {
-            return m_options.cend();
+            return GetContents().options.cend();
         }
 
         inline typename std::vector<Switch<CHAR>>::const_iterator SwitchesBegin() const
         {
-            return m_switches.cbegin();
+            return GetContents().switches.cbegin();
         }
 
         inline typename std::vector<Switch<CHAR>>::const_iterator SwitchesEnd() const
         {
-            return m_switches.cend();
+            return GetContents().switches.cend();
         }
 
         inline typename std::vector<Argument<CHAR>>::const_iterator ArgumentsBegin() const
         {
-            return m_arguments.cbegin();
+            return GetContents().arguments.cbegin();
         }
 
         inline typename std::vector<Argument<CHAR>>::const_iterator ArgumentsEnd() const
         {
-            return m_arguments.cend();
+            return GetContents().arguments.cend();
+        }
+
+        /// <summary>
+        /// Returns true if any Option or Switch of this container takes its value from the environment
+        /// </summary>
+        inline bool HasEnvironmentFallbacks() const noexcept
+        {
+            return GetContents().withEnvironment;
+        }
+
+        /// <summary>
+        /// Returns the first Command of this container matching `key`, or nullptr
+        /// </summary>
+        Command<CHAR> const* FindCommand(typename NameIndex<CHAR>::Key const& key) const
+        {
+            Contents const& c = GetContents();
+            size_t i = c.nameIndex.Find(key, NameIndex<CHAR>::Kind::Command,
+                                        [&](size_t i) { return c.commands[i].IsMatch(key.GetString()); });
+            return (i == NameIndex<CHAR>::npos) ? nullptr : &c.commands[i];
+        }
+
+        /// <summary>
+        /// Returns the first Option of this container matching `key`, or nullptr
+        /// </summary>
+        Option<CHAR> const* FindOption(typename NameIndex<CHAR>::Key const& key) const
+        {
+            Contents const& c = GetContents();
+            size_t i = c.nameIndex.Find(key, NameIndex<CHAR>::Kind::Option,
+                                        [&](size_t i) { return c.options[i].IsMatch(key.GetString()); });
+            return (i == NameIndex<CHAR>::npos) ? nullptr : &c.options[i];
+        }
+
+        /// <summary>
+        /// Returns the first Switch of this container matching `key`, or nullptr
+        /// </summary>
+        Switch<CHAR> const* FindSwitch(typename NameIndex<CHAR>::Key const& key) const
+        {
+            Contents const& c = GetContents();
+            size_t i = c.nameIndex.Find(key, NameIndex<CHAR>::Kind::Switch,
+                                        [&](size_t i) { return c.switches[i].IsMatch(key.GetString()); });
+            return (i == NameIndex<CHAR>::npos) ? nullptr : &c.switches[i];
         }
 
     private:
-        std::vector<Command<CHAR>> m_commands;
-        std::vector<Option<CHAR>> m_options;
-        std::vector<Switch<CHAR>> m_switches;
-        std::vector<Argument<CHAR>> m_arguments;
+        struct Contents
+        {
+            NameIndex<CHAR> nameIndex;
+            std::vector<Command<CHAR>> commands;
+            std::vector<Option<CHAR>> options;
+            std::vector<Switch<CHAR>> switches;
+            std::vector<Argument<CHAR>> arguments;
+            // true if any Option or Switch takes its value from the environment
+            bool withEnvironment{false};
+        };
+
+        inline Contents const& GetContents() const noexcept
+        {
+            static const Contents empty{};
+            return m_contents ? *m_contents : empty;
+        }
+
+        /// <summary>
+        /// Returns the contents for changing, after copying them if they are shared with other copies
+        /// </summary>
+        Contents& MutableContents()
+        {
+            if (!m_contents)
+            {
+                m_contents = std::make_shared<Contents>();
+            }
+            else if (m_contents.use_count() > 1)
+            {
+                m_contents = std::make_shared<Contents>(*m_contents);
+            }
+            return *m_contents;
+        }
+
+        std::shared_ptr<Contents> m_contents;
     };
 
     template <typename CHAR>
@@ -605,40 +1436,1599 @@ namespace yaclap
         {
             throw std::invalid_argument("command");
         }
-        m_commands.push_back(command);
+        Contents& c = MutableContents();
+        c.nameIndex.Add(NameIndex<CHAR>::Kind::Command, c.commands.size(), command);
+        c.commands.push_back(command);
     }
 
+    /// <summary>
+    /// Splits a command line text into its arguments.
+    /// Arguments are separated by white space. Single quotes and double quotes group text including white space into
+    /// one argument, and are removed. Outside of quotes, a backslash escapes a following quote or white space
+    /// character. Inside double quotes, a backslash escapes a following double quote. All other backslashes are kept
+    /// as they are, to keep Windows paths intact.
+    /// </summary>
     template <typename CHAR>
-    class Parser : public WithCommandContainer<CHAR>, public WithName<CHAR>, public WithDescription<CHAR>
+    class Tokenizer
     {
     public:
-        template <typename TSTR1, typename TSTR2>
-        Parser(const TSTR1& name, const TSTR2& description)
-            : WithCommandContainer<CHAR>{}, WithName<CHAR>{name}, WithDescription<CHAR>{description}
+        static inline bool IsSpace(CHAR c) noexcept
         {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
         }
 
-        Parser& AddCommand(const Command<CHAR>& command)
+        static inline bool IsSpecial(CHAR c) noexcept
         {
-            WithCommandContainer<CHAR>::AddCommandImpl(command);
-            return *this;
+            return c == '"' || c == '\'' || c == '\\';
         }
 
-        Parser& AddOption(const Option<CHAR>& option)
+        /// <summary>
+        /// Returns true if the backslash at `p` escapes the following character, outside of quotes
+        /// </summary>
+        static inline bool IsEscape(const CHAR* p, const CHAR* end) noexcept
         {
-            WithCommandContainer<CHAR>::AddOptionImpl(option);
-            return *this;
+            return p + 1 < end && (p[1] == '"' || p[1] == '\'' || IsSpace(p[1]));
         }
 
-        Parser& AddSwitch(const Switch<CHAR>& switchOption)
+        /// <summary>
+        /// Returns the first white space or special character in [`p`, `end`), or `end`
+        /// </summary>
+        static const CHAR* FindSpaceOrSpecial(const CHAR* p, const CHAR* end) noexcept
         {
-            WithCommandContainer<CHAR>::AddSwitchImpl(switchOption);
-            return *this;
+#ifdef YACLAP_SSE2
+            using V = Sse2<CHAR>;
+            for (; end - p >= static_cast<ptrdiff_t>(V::lanes); p += V::lanes)
+            {
+                const __m128i v = V::Load(p);
+                // '\t'..'\r' are 0x09..0x0D
+                const __m128i control = _mm_and_si128(V::Greater(v, V::Set(0x08)), V::Greater(V::Set(0x0E), v));
+                const __m128i found = _mm_or_si128(
+                    _mm_or_si128(control, V::Equal(v, V::Set(' '))),
+                    _mm_or_si128(_mm_or_si128(V::Equal(v, V::Set('"')), V::Equal(v, V::Set('\''))),
+                                 V::Equal(v, V::Set('\\'))));
+                const size_t lane = V::FirstLane(found);
+                if (lane < V::lanes)
+                {
+                    return p + lane;
+                }
+            }
+#endif
+            while (p < end && !IsSpace(*p) && !IsSpecial(*p))
+            {
+                ++p;
+            }
+            return p;
         }
 
-        Parser& AddArgument(const Argument<CHAR>& argument)
+        /// <summary>
+        /// Tokenizes the text [`begin`, `end`), calling `onToken` with a `std::basic_string_view<CHAR>` for each
+        /// argument. Arguments without quotes and escapes are views into the text. Arguments with quotes or escapes
+        /// are written, with the quotes and escapes removed, into the buffer returned by `getBuffer`, at the same
+        /// offset as in the text. `getBuffer` is only called if such an argument is present, and must return memory
+        /// at least as large as the text, or the text itself to tokenize in place.
+        /// Returns false if the text ends within quotes.
+        /// </summary>
+        template <typename GETBUFFER, typename ONTOKEN>
+        static bool Tokenize(const CHAR* begin, const CHAR* end, GETBUFFER&& getBuffer, ONTOKEN&& onToken)
+        {
+            const CHAR* p = begin;
+            CHAR* buffer = nullptr;
+            while (true)
+            {
+                while (p < end && IsSpace(*p))
+                {
+                    ++p;
+                }
+                if (p == end)
+                {
+                    return true;
+                }
+
+                const CHAR* start = p;
+                p = FindSpaceOrSpecial(p, end);
+                while (p < end && *p == '\\' && !IsEscape(p, end))
+                {
+                    p = FindSpaceOrSpecial(p + 1, end);
+                }
+                if (p == end || IsSpace(*p))
+                {
+                    onToken(std::basic_string_view<CHAR>{start, static_cast<size_t>(p - start)});
+                    continue;
+                }
+
+                if (buffer == nullptr)
+                {
+                    buffer = getBuffer();
+                }
+                // The output never overtakes the input, so writing in place is safe
+                CHAR* const out = buffer + (start - begin);
+                CHAR* o = out;
+                if (o != start)
+                {
+                    std::copy(start, p, o);
+                }
+                o += p - start;
+
+                CHAR quote = 0;
+                while (p < end)
+                {
+                    const CHAR c = *p;
+                    if (quote != 0)
+                    {
+                        if (c == quote)
+                        {
+                            quote = 0;
+                        }
+                        else if (quote == '"' && c == '\\' && p + 1 < end && p[1] == '"')
+                        {
+                            *o++ = *++p;
+                        }
+                        else
+                        {
+                            *o++ = c;
+                        }
+                    }
+                    else if (IsSpace(c))
+                    {
+                        break;
+                    }
+                    else if (c == '"' || c == '\'')
+                    {
+                        quote = c;
+                    }
+                    else if (c == '\\' && IsEscape(p, end))
+                    {
+                        *o++ = *++p;
+                    }
+                    else
+                    {
+                        *o++ = c;
+                    }
+                    ++p;
+                }
+                if (quote != 0)
+                {
+                    return false;
+                }
+                onToken(std::basic_string_view<CHAR>{out, static_cast<size_t>(o - out)});
+            }
+        }
+    };
+
+    /// <summary>
+    /// Parses numbers from value strings without allocating memory.
+    /// Decimal digits are converted in blocks of eight characters at once, packed into one 64 bit word (SWAR).
+    /// Binary, octal, and hexadecimal digits are accumulated by shifting. Overflow is detected exactly for the
+    /// requested target type.
+    /// </summary>
+    template <typename CHAR>
+    class NumberParser
+    {
+    public:
+        enum class Status
+        {
+            Ok,
+            MissingInput,
+            UnexpectedChar,
+            DataTypeLimit
+        };
+
+        /// <summary>
+        /// Removes leading and trailing white space from [`b`, `e`)
+        /// </summary>
+        static inline void Trim(const CHAR*& b, const CHAR*& e) noexcept
+        {
+            while (b != e && Tokenizer<CHAR>::IsSpace(*b))
+            {
+                ++b;
+            }
+            while (b != e && Tokenizer<CHAR>::IsSpace(*(e - 1)))
+            {
+                --e;
+            }
+        }
+
+        /// <summary>
+        /// Returns the value of a digit of up to base 36, or 0xFF if `c` is not a digit
+        /// </summary>
+        static inline unsigned DigitValue(CHAR c) noexcept
+        {
+            const uint32_t u = static_cast<uint32_t>(static_cast<std::make_unsigned_t<CHAR>>(c));
+            if (u - '0' < 10)
+            {
+                return u - '0';
+            }
+            if ((u | 0x20) - 'a' < 26)
+            {
+                return (u | 0x20) - 'a' + 10;
+            }
+            return 0xFF;
+        }
+
+        /// <summary>
+        /// The sign and magnitude of a parsed integer, before it is converted to a target type
+        /// </summary>
+        struct IntegerParts
+        {
+            Status status{Status::MissingInput};
+            bool negative{false};
+            uint64_t magnitude{0};
+            size_t errorAt{0};
+        };
+
+        /// <summary>
+        /// Parses the integer syntax of `ResultValueView::AsInteger` from the trimmed string [`b`, `e`).
+        /// On `Status::UnexpectedChar`, `errorAt` is set to the offset of the offending character.
+        /// </summary>
+        static IntegerParts ParseIntegerParts(const CHAR* b, const CHAR* e) noexcept
+        {
+            IntegerParts parts;
+            const CHAR* p = b;
+            if (p != e && (*p == '+' || *p == '-'))
+            {
+                parts.negative = (*p == '-');
+                ++p;
+            }
+            unsigned base = 10;
+            if (p != e)
+            {
+                switch (*p | 0x20)
+                {
+                    case 'x':
+                        base = 16;
+                        ++p;
+                        break;
+                    case 'o':
+                        base = 8;
+                        ++p;
+                        break;
+                    case 'b':
+                        base = 2;
+                        ++p;
+                        break;
+                }
+            }
+            if (p == e)
+            {
+                parts.status = Status::MissingInput;
+                return parts;
+            }
+
+            const CHAR* stop = (base == 10) ? ParseDecimal(p, e, parts.magnitude)
+                                            : ParsePowerOfTwo(p, e, base, parts.magnitude);
+            if (stop == nullptr)
+            {
+                parts.status = Status::DataTypeLimit;
+            }
+            else if (stop != e)
+            {
+                parts.errorAt = static_cast<size_t>(stop - b);
+                parts.status = Status::UnexpectedChar;
+            }
+            else
+            {
+                parts.status = Status::Ok;
+            }
+            return parts;
+        }
+
+        /// <summary>
+        /// Converts successfully parsed `parts` into `T`, checking the range of the type exactly
+        /// </summary>
+        template <typename T>
+        static Status ToInteger(IntegerParts const& parts, T& out) noexcept
+        {
+            static_assert(std::is_integral_v<T> && sizeof(T) <= sizeof(uint64_t), "unsupported integer type");
+
+            using U = std::make_unsigned_t<T>;
+            if constexpr (std::is_signed_v<T>)
+            {
+                if (parts.negative)
+                {
+                    if (parts.magnitude > static_cast<uint64_t>((std::numeric_limits<T>::max)()) + 1)
+                    {
+                        return Status::DataTypeLimit;
+                    }
+                    out = (parts.magnitude == 0) ? 0 : static_cast<T>(-static_cast<T>(parts.magnitude - 1) - 1);
+                    return Status::Ok;
+                }
+            }
+            else
+            {
+                if (parts.negative && parts.magnitude != 0)
+                {
+                    return Status::DataTypeLimit;
+                }
+            }
+            if (parts.magnitude > static_cast<uint64_t>((std::numeric_limits<T>::max)()))
+            {
+                return Status::DataTypeLimit;
+            }
+            out = static_cast<T>(static_cast<U>(parts.magnitude));
+            return Status::Ok;
+        }
+
+        /// <summary>
+        /// Parses the integer syntax of `ResultValueView::AsInteger` from the trimmed string [`b`, `e`) into `T`.
+        /// On `Status::UnexpectedChar`, `errorAt` is set to the offset of the offending character.
+        /// </summary>
+        template <typename T>
+        static Status ParseInteger(const CHAR* b, const CHAR* e, T& out, size_t& errorAt) noexcept
+        {
+            const IntegerParts parts = ParseIntegerParts(b, e);
+            if (parts.status != Status::Ok)
+            {
+                errorAt = parts.errorAt;
+                return parts.status;
+            }
+            return ToInteger(parts, out);
+        }
+
+        /// <summary>
+        /// Parses the floating-point syntax of `ResultValueView::AsDouble` from the trimmed string [`b`, `e`),
+        /// correctly rounded to `T`.
+        /// Values with up to 19 significant digits, which are exactly representable and scaled by an exactly
+        /// representable power of ten, are computed with a single floating-point operation (Clinger's fast path).
+        /// All other values are converted by `std::from_chars`, or `strtod` if that is not available.
+        /// On `Status::UnexpectedChar`, `errorAt` is set to the offset of the offending character.
+        /// </summary>
+        template <typename T>
+        static Status ParseFloat(const CHAR* b, const CHAR* e, T& out, size_t& errorAt)
+        {
+            static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>, "unsupported floating-point type");
+
+            // [+-]?[0..9]*\.?[0..9]*([eE][+-]?[0..9]+)?
+            const CHAR* p = b;
+            bool neg = false;
+            if (p != e && (*p == '+' || *p == '-'))
+            {
+                neg = (*p == '-');
+                ++p;
+            }
+            const CHAR* const numberBegin = p;
+
+            uint64_t mantissa = 0;
+            int digits = 0;      // significant digits in `mantissa`, without leading zeros
+            int exponent = 0;    // decimal exponent of the least significant digit in `mantissa`
+            bool truncated = false;
+            bool anyDigit = false;
+            bool fraction = false;
+            for (; p != e; ++p)
+            {
+                const uint32_t d = static_cast<uint32_t>(static_cast<std::make_unsigned_t<CHAR>>(*p)) - '0';
+                if (d < 10)
+                {
+                    anyDigit = true;
+                    if (digits < 19)
+                    {
+                        mantissa = mantissa * 10 + d;
+                        digits += (mantissa != 0) ? 1 : 0;
+                        exponent -= fraction ? 1 : 0;
+                    }
+                    else
+                    {
+                        truncated = truncated || (d != 0);
+                        exponent += fraction ? 0 : 1;
+                    }
+                    continue;
+                }
+                if (*p == '.' && !fraction)
+                {
+                    fraction = true;
+                    continue;
+                }
+                break;
+            }
+            if (!anyDigit)
+            {
+                if (p == e)
+                {
+                    return Status::MissingInput;
+                }
+                errorAt = static_cast<size_t>(p - b);
+                return Status::UnexpectedChar;
+            }
+
+            if (p != e && (*p == 'e' || *p == 'E'))
+            {
+                ++p;
+                bool negExp = false;
+                if (p != e && (*p == '+' || *p == '-'))
+                {
+                    negExp = (*p == '-');
+                    ++p;
+                }
+                if (p == e)
+                {
+                    return Status::MissingInput;
+                }
+                int expVal = 0;
+                for (; p != e; ++p)
+                {
+                    const uint32_t d = static_cast<uint32_t>(static_cast<std::make_unsigned_t<CHAR>>(*p)) - '0';
+                    if (d >= 10)
+                    {
+                        break;
+                    }
+                    // saturate, any larger exponent is out of range of all types anyway
+                    expVal = (expVal < 100000) ? expVal * 10 + static_cast<int>(d) : expVal;
+                }
+                exponent += negExp ? -expVal : expVal;
+            }
+            if (p != e)
+            {
+                errorAt = static_cast<size_t>(p - b);
+                return Status::UnexpectedChar;
+            }
+
+            constexpr uint64_t maxExactMantissa = uint64_t{1} << std::numeric_limits<T>::digits;
+            constexpr int maxExactExponent = std::is_same_v<T, float> ? 10 : 22;
+            if (!truncated && mantissa <= maxExactMantissa && exponent >= -maxExactExponent &&
+                exponent <= maxExactExponent)
+            {
+                T v = static_cast<T>(mantissa);
+                v = (exponent < 0) ? v / ExactPowerOfTen<T>(-exponent) : v * ExactPowerOfTen<T>(exponent);
+                out = neg ? -v : v;
+                return Status::Ok;
+            }
+            if (mantissa == 0 && !truncated)
+            {
+                out = neg ? -T{0} : T{0};
+                return Status::Ok;
+            }
+
+            return ParseFloatSlow(numberBegin, e, neg, exponent + digits > 0, out);
+        }
+
+    private:
+        template <typename T>
+        static inline T ExactPowerOfTen(int e) noexcept
+        {
+            // all powers of ten up to 1e22 are exactly representable as double, and up to 1e10 as float
+            constexpr double powers[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                         1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+            return static_cast<T>(powers[e]);
+        }
+
+        /// <summary>
+        /// Converts the already validated number [`b`, `e`), without sign, with the correctly rounding conversion of
+        /// the standard library. `aboveOne` tells if the magnitude is at least one, to tell an overflow from an
+        /// underflow if the value is out of range.
+        /// </summary>
+        template <typename T>
+        static Status ParseFloatSlow(const CHAR* b, const CHAR* e, bool neg, bool aboveOne, T& out)
+        {
+            const size_t len = static_cast<size_t>(e - b);
+            char local[64];
+            std::string heap;
+            const char* text;
+            if constexpr (std::is_same_v<CHAR, char>)
+            {
+                text = b;
+            }
+            else
+            {
+                char* narrow = local;
+                if (len >= sizeof(local))
+                {
+                    heap.resize(len + 1);
+                    narrow = heap.data();
+                }
+                // the syntax has been validated, so all characters are ASCII
+                std::transform(b, e, narrow, [](CHAR c) { return static_cast<char>(c); });
+                narrow[len] = 0;
+                text = narrow;
+            }
+
+            T v{};
+            bool outOfRange = false;
+#if defined(__cpp_lib_to_chars) && (__cpp_lib_to_chars >= 201611L)
+            const std::from_chars_result r = std::from_chars(text, text + len, v, std::chars_format::general);
+            outOfRange = (r.ec == std::errc::result_out_of_range);
+#else
+            // strtod requires zero-terminated input, and uses the decimal point of the current C locale
+            if constexpr (std::is_same_v<CHAR, char>)
+            {
+                heap.assign(text, len);
+                text = heap.c_str();
+            }
+            errno = 0;
+            v = std::is_same_v<T, float> ? static_cast<T>(std::strtof(text, nullptr))
+                                         : static_cast<T>(std::strtod(text, nullptr));
+            outOfRange = (errno == ERANGE) && (v == T{0} || std::isinf(v));
+#endif
+            if (outOfRange)
+            {
+                if (aboveOne)
+                {
+                    return Status::DataTypeLimit;
+                }
+                v = T{0};
+            }
+            out = neg ? -v : v;
+            return Status::Ok;
+        }
+
+        /// <summary>
+        /// Packs eight characters into the bytes of one word, the first character in the lowest byte.
+        /// Characters outside of the byte range are packed as 0xFF, which is no digit.
+        /// </summary>
+        static inline uint64_t Pack8(const CHAR* p) noexcept
+        {
+            uint64_t v = 0;
+            for (unsigned i = 0; i < 8; ++i)
+            {
+                const auto c = static_cast<std::make_unsigned_t<CHAR>>(p[i]);
+                v |= static_cast<uint64_t>(c > 0xFF ? 0xFF : c) << (8 * i);
+            }
+            return v;
+        }
+
+        static inline bool AreEightDigits(uint64_t v) noexcept
+        {
+            // every byte must be 0x30..0x39: the high nibble must be 3, and adding 6 must not carry into it
+            return ((v & 0xF0F0F0F0F0F0F0F0ull) | (((v + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) ==
+                   0x3333333333333333ull;
+        }
+
+        static inline uint64_t EightDigitsValue(uint64_t v) noexcept
+        {
+            // combine neighboring digits to 2-digit, then 4-digit, then the 8-digit value
+            v = ((v & 0x0F0F0F0F0F0F0F0Full) * 2561) >> 8;
+            v = ((v & 0x00FF00FF00FF00FFull) * 6553601) >> 16;
+            return ((v & 0x0000FFFF0000FFFFull) * 42949672960001ull) >> 32;
+        }
+
+        /// <summary>
+        /// Returns the first character which is no decimal digit, or nullptr on overflow of 64 bit
+        /// </summary>
+        static const CHAR* ParseDecimal(const CHAR* p, const CHAR* e, uint64_t& v) noexcept
+        {
+            constexpr uint64_t max = (std::numeric_limits<uint64_t>::max)();
+            for (; e - p >= 8; p += 8)
+            {
+                const uint64_t packed = Pack8(p);
+                if (!AreEightDigits(packed))
+                {
+                    break;
+                }
+                const uint64_t block = EightDigitsValue(packed);
+                if (v > (max - block) / 100000000u)
+                {
+                    return nullptr;
+                }
+                v = v * 100000000u + block;
+            }
+            for (; p != e; ++p)
+            {
+                const uint64_t d = static_cast<uint64_t>(static_cast<std::make_unsigned_t<CHAR>>(*p)) - '0';
+                if (d >= 10)
+                {
+                    break;
+                }
+                if (v > max / 10 || (v == max / 10 && d > max % 10))
+                {
+                    return nullptr;
+                }
+                v = v * 10 + d;
+            }
+            return p;
+        }
+
+        /// <summary>
+        /// Returns the first character which is no digit of `base`, or nullptr on overflow of 64 bit
+        /// </summary>
+        static const CHAR* ParsePowerOfTwo(const CHAR* p, const CHAR* e, unsigned base, uint64_t& v) noexcept
+        {
+            const unsigned shift = (base == 16) ? 4 : (base == 8) ? 3 : 1;
+            for (; p != e; ++p)
+            {
+                const unsigned d = DigitValue(*p);
+                if (d >= base)
+                {
+                    break;
+                }
+                if ((v >> (64 - shift)) != 0)
+                {
+                    return nullptr;
+                }
+                v = (v << shift) | d;
+            }
+            return p;
+        }
+    };
+
+    /// <summary>
+    /// The elements of a delimited list value, e.g. `1,2,3`, as views into the value string.
+    /// The delimiters are searched with SSE2 while iterating, so splitting does not allocate memory.
+    /// An empty value has no elements, otherwise there is one element more than there are delimiters.
+    /// </summary>
+    template <typename CHAR>
+    class ValueList
+    {
+    public:
+        class Iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::basic_string_view<CHAR>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const value_type*;
+            using reference = value_type;
+
+            Iterator() noexcept = default;
+
+            Iterator(const CHAR* p, const CHAR* end, CHAR delimiter) noexcept
+                : m_p{p}, m_elementEnd{Find(p, end, delimiter)}, m_end{end}, m_delimiter{delimiter}
+            {
+            }
+
+            inline value_type operator*() const noexcept
+            {
+                return value_type{m_p, static_cast<size_t>(m_elementEnd - m_p)};
+            }
+
+            Iterator& operator++() noexcept
+            {
+                if (m_elementEnd == m_end)
+                {
+                    m_p = nullptr;
+                    m_elementEnd = nullptr;
+                }
+                else
+                {
+                    m_p = m_elementEnd + 1;
+                    m_elementEnd = Find(m_p, m_end, m_delimiter);
+                }
+                return *this;
+            }
+
+            Iterator operator++(int) noexcept
+            {
+                Iterator i{*this};
+                ++*this;
+                return i;
+            }
+
+            inline bool operator==(Iterator const& other) const noexcept
+            {
+                return m_p == other.m_p;
+            }
+
+            inline bool operator!=(Iterator const& other) const noexcept
+            {
+                return m_p != other.m_p;
+            }
+
+        private:
+            const CHAR* m_p{nullptr};
+            const CHAR* m_elementEnd{nullptr};
+            const CHAR* m_end{nullptr};
+            CHAR m_delimiter{0};
+        };
+
+        ValueList(std::basic_string_view<CHAR> value, CHAR delimiter) noexcept
+            : m_value{value}, m_delimiter{delimiter}
+        {
+        }
+
+        inline Iterator begin() const noexcept
+        {
+            if (m_value.empty())
+            {
+                return Iterator{};
+            }
+            return Iterator{m_value.data(), m_value.data() + m_value.size(), m_delimiter};
+        }
+
+        inline Iterator end() const noexcept
+        {
+            return Iterator{};
+        }
+
+        inline bool empty() const noexcept
+        {
+            return m_value.empty();
+        }
+
+        /// <summary>
+        /// Counts the elements, in one pass over the value
+        /// </summary>
+        size_t size() const noexcept
+        {
+            if (m_value.empty())
+            {
+                return 0;
+            }
+            return 1 + Count(m_value.data(), m_value.data() + m_value.size(), m_delimiter);
+        }
+
+        /// <summary>
+        /// Returns the first occurrence of `c` in [`p`, `end`), or `end`
+        /// </summary>
+        static const CHAR* Find(const CHAR* p, const CHAR* end, CHAR c) noexcept
+        {
+#ifdef YACLAP_SSE2
+            using V = Sse2<CHAR>;
+            const __m128i needle = V::Set(c);
+            for (; end - p >= static_cast<ptrdiff_t>(V::lanes); p += V::lanes)
+            {
+                const size_t lane = V::FirstLane(V::Equal(V::Load(p), needle));
+                if (lane < V::lanes)
+                {
+                    return p + lane;
+                }
+            }
+#endif
+            while (p != end && *p != c)
+            {
+                ++p;
+            }
+            return p;
+        }
+
+        /// <summary>
+        /// Returns the number of occurrences of `c` in [`p`, `end`)
+        /// </summary>
+        static size_t Count(const CHAR* p, const CHAR* end, CHAR c) noexcept
+        {
+            size_t count = 0;
+#ifdef YACLAP_SSE2
+            using V = Sse2<CHAR>;
+            const __m128i needle = V::Set(c);
+            for (; end - p >= static_cast<ptrdiff_t>(V::lanes); p += V::lanes)
+            {
+                uint32_t bits = static_cast<uint32_t>(_mm_movemask_epi8(V::Equal(V::Load(p), needle)));
+                // population count, each matching lane sets sizeof(CHAR) bits
+                bits = bits - ((bits >> 1) & 0x55555555u);
+                bits = (bits & 0x33333333u) + ((bits >> 2) & 0x33333333u);
+                count += ((((bits + (bits >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24) / sizeof(CHAR);
+            }
+#endif
+            for (; p != end; ++p)
+            {
+                count += (*p == c) ? 1 : 0;
+            }
+            return count;
+        }
+
+    private:
+        std::basic_string_view<CHAR> m_value;
+        CHAR m_delimiter;
+    };
+
+    /// <summary>
+    /// A set of unsigned integers, stored as sorted, disjoint, and non-adjacent closed intervals, e.g. parsed from
+    /// the range list `0-3,8-15,32`. Ranges are never expanded element by element.
+    /// </summary>
+    class RangeList
+    {
+    public:
+        struct Interval
+        {
+            uint64_t first;
+            uint64_t last;
+
+            inline bool operator==(Interval const& other) const noexcept
+            {
+                return first == other.first && last == other.last;
+            }
+        };
+
+        RangeList() noexcept = default;
+
+        /// <summary>
+        /// Adds the closed interval [`first`, `last`]. Call `Normalize` after adding all intervals.
+        /// </summary>
+        inline void Add(uint64_t first, uint64_t last)
+        {
+            m_intervals.push_back(Interval{first, last});
+        }
+
+        /// <summary>
+        /// Sorts the intervals and merges overlapping and adjacent ones
+        /// </summary>
+        void Normalize()
+        {
+            if (!std::is_sorted(m_intervals.cbegin(), m_intervals.cend(),
+                                [](Interval const& a, Interval const& b) { return a.first < b.first; }))
+            {
+                std::sort(m_intervals.begin(), m_intervals.end(),
+                          [](Interval const& a, Interval const& b) { return a.first < b.first; });
+            }
+            size_t out = 0;
+            for (size_t i = 1; i < m_intervals.size(); ++i)
+            {
+                Interval& merged = m_intervals[out];
+                Interval const& next = m_intervals[i];
+                if (merged.last == (std::numeric_limits<uint64_t>::max)() || next.first <= merged.last + 1)
+                {
+                    merged.last = (std::max)(merged.last, next.last);
+                }
+                else
+                {
+                    m_intervals[++out] = next;
+                }
+            }
+            if (!m_intervals.empty())
+            {
+                m_intervals.resize(out + 1);
+            }
+        }
+
+        inline std::vector<Interval> const& Intervals() const noexcept
+        {
+            return m_intervals;
+        }
+
+        inline bool Empty() const noexcept
+        {
+            return m_intervals.empty();
+        }
+
+        bool Contains(uint64_t value) const noexcept
+        {
+            auto it = std::upper_bound(m_intervals.cbegin(), m_intervals.cend(), value,
+                                       [](uint64_t v, Interval const& i) { return v < i.first; });
+            return it != m_intervals.cbegin() && value <= (it - 1)->last;
+        }
+
+        /// <summary>
+        /// Returns the number of values in the set, saturating at the maximum of uint64_t
+        /// </summary>
+        uint64_t Count() const noexcept
+        {
+            uint64_t count = 0;
+            for (Interval const& i : m_intervals)
+            {
+                const uint64_t n = i.last - i.first;
+                if (n >= (std::numeric_limits<uint64_t>::max)() - count)
+                {
+                    return (std::numeric_limits<uint64_t>::max)();
+                }
+                count += n + 1;
+            }
+            return count;
+        }
+
+        /// <summary>
+        /// Sets the bits of all values in the set in the bitset `words` of `wordCount` 64 bit words.
+        /// Value `v` is bit `v % 64` of word `v / 64`. Values beyond the bitset are ignored. Whole words are filled at
+        /// once.
+        /// </summary>
+        void ToBits(uint64_t* words, size_t wordCount) const noexcept
+        {
+            const uint64_t bitCount = static_cast<uint64_t>(wordCount) * 64;
+            for (Interval const& i : m_intervals)
+            {
+                if (i.first >= bitCount)
+                {
+                    break;
+                }
+                const uint64_t last = (std::min)(i.last, bitCount - 1);
+                const size_t firstWord = static_cast<size_t>(i.first / 64);
+                const size_t lastWord = static_cast<size_t>(last / 64);
+                const uint64_t firstMask = ~uint64_t{0} << (i.first % 64);
+                const uint64_t lastMask = ~uint64_t{0} >> (63 - last % 64);
+                if (firstWord == lastWord)
+                {
+                    words[firstWord] |= firstMask & lastMask;
+                    continue;
+                }
+                words[firstWord] |= firstMask;
+                std::fill(words + firstWord + 1, words + lastWord, ~uint64_t{0});
+                words[lastWord] |= lastMask;
+            }
+        }
+
+        /// <summary>
+        /// Returns the set as bitset, in which values beyond `N` are ignored
+        /// </summary>
+        template <size_t N>
+        std::bitset<N> ToBitset() const
+        {
+            uint64_t words[(N + 63) / 64]{};
+            ToBits(words, (N + 63) / 64);
+            std::bitset<N> bits;
+            for (size_t w = (N + 63) / 64; w > 0; --w)
+            {
+                bits <<= 64;
+                bits |= std::bitset<N>{words[w - 1]};
+            }
+            return bits;
+        }
+
+    private:
+        std::vector<Interval> m_intervals;
+    };
+
+    /// <summary>
+    /// A response file mapped into memory with copy-on-write access, so that it can be tokenized in place.
+    /// The text is the file content as is for `char`, skipping an UTF-8 byte order mark. For `wchar_t`, files with an
+    /// UTF-16 LE byte order mark are used as is, if `wchar_t` is 16 bit wide, and all other files are converted from
+    /// UTF-8.
+    /// </summary>
+    template <typename CHAR>
+    class ResponseFile
+    {
+    public:
+        ResponseFile(const ResponseFile&) = delete;
+        ResponseFile& operator=(const ResponseFile&) = delete;
+
+        ~ResponseFile()
+        {
+            if (m_data != nullptr)
+            {
+#ifdef _WIN32
+                UnmapViewOfFile(m_data);
+#else
+                munmap(m_data, m_size);
+#endif
+            }
+        }
+
+        /// <summary>
+        /// Maps the file into memory. Returns nullptr if the file cannot be read.
+        /// </summary>
+        static std::shared_ptr<ResponseFile> Open(const std::filesystem::path& path)
+        {
+            std::shared_ptr<ResponseFile> file{new ResponseFile{}};
+#ifdef _WIN32
+            HANDLE h = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                   FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (h == INVALID_HANDLE_VALUE)
+            {
+                return nullptr;
+            }
+            LARGE_INTEGER size;
+            if (!GetFileSizeEx(h, &size))
+            {
+                CloseHandle(h);
+                return nullptr;
+            }
+            if (size.QuadPart > 0)
+            {
+                HANDLE mapping = CreateFileMappingW(h, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+                if (mapping != nullptr)
+                {
+                    file->m_data = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+                    CloseHandle(mapping);
+                }
+                if (file->m_data == nullptr)
+                {
+                    CloseHandle(h);
+                    return nullptr;
+                }
+                file->m_size = static_cast<size_t>(size.QuadPart);
+            }
+            CloseHandle(h);
+#else
+            const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+            {
+                return nullptr;
+            }
+            struct stat st;
+            if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+            {
+                close(fd);
+                return nullptr;
+            }
+            if (st.st_size > 0)
+            {
+                void* data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+                if (data == MAP_FAILED)
+                {
+                    close(fd);
+                    return nullptr;
+                }
+                file->m_data = data;
+                file->m_size = static_cast<size_t>(st.st_size);
+            }
+            close(fd);
+#endif
+            file->InitText();
+            return file;
+        }
+
+        inline CHAR* TextBegin() const noexcept
+        {
+            return m_text;
+        }
+
+        inline CHAR* TextEnd() const noexcept
+        {
+            return m_text + m_textLength;
+        }
+
+    private:
+        ResponseFile() noexcept = default;
+
+        void InitText()
+        {
+            unsigned char* bytes = static_cast<unsigned char*>(m_data);
+            size_t size = m_size;
+            if (size >= 3 && bytes[0] == 0xEF && bytes[1] == 0xBB && bytes[2] == 0xBF)
+            {
+                bytes += 3;
+                size -= 3;
+            }
+            else if constexpr (sizeof(CHAR) == 2)
+            {
+                if (size >= 2 && bytes[0] == 0xFF && bytes[1] == 0xFE)
+                {
+                    m_text = reinterpret_cast<CHAR*>(bytes + 2);
+                    m_textLength = (size - 2) / 2;
+                    return;
+                }
+            }
+
+            if constexpr (sizeof(CHAR) == 1)
+            {
+                m_text = reinterpret_cast<CHAR*>(bytes);
+                m_textLength = size;
+            }
+            else
+            {
+                DecodeUtf8(bytes, bytes + size, m_converted);
+                m_text = m_converted.data();
+                m_textLength = m_converted.size();
+            }
+        }
+
+    public:
+        /// <summary>
+        /// Appends the UTF-8 text [`p`, `end`) to `out`, as UTF-16 if `CHAR` is 16 bit wide
+        /// </summary>
+        static void DecodeUtf8(const unsigned char* p, const unsigned char* end, std::basic_string<CHAR>& out)
+        {
+            out.reserve(out.size() + static_cast<size_t>(end - p));
+            while (p < end)
+            {
+                uint32_t cp = *p++;
+                int follow = 0;
+                if (cp >= 0xF0)
+                {
+                    cp &= 0x07;
+                    follow = 3;
+                }
+                else if (cp >= 0xE0)
+                {
+                    cp &= 0x0F;
+                    follow = 2;
+                }
+                else if (cp >= 0xC0)
+                {
+                    cp &= 0x1F;
+                    follow = 1;
+                }
+                for (; follow > 0 && p < end && (*p & 0xC0) == 0x80; --follow)
+                {
+                    cp = (cp << 6) | (*p++ & 0x3F);
+                }
+                if (sizeof(CHAR) == 2 && cp >= 0x10000)
+                {
+                    cp -= 0x10000;
+                    out.push_back(static_cast<CHAR>(0xD800 + (cp >> 10)));
+                    out.push_back(static_cast<CHAR>(0xDC00 + (cp & 0x3FF)));
+                }
+                else
+                {
+                    out.push_back(static_cast<CHAR>(cp));
+                }
+            }
+        }
+
+    private:
+        void* m_data = nullptr;
+        size_t m_size = 0;
+        CHAR* m_text = nullptr;
+        size_t m_textLength = 0;
+        std::basic_string<CHAR> m_converted;
+    };
+
+    /// <summary>
+    /// A snapshot of environment variables, indexed by name, from which Options and Switches declared with
+    /// `FromEnvironment` take their values if they are missing from the command line.
+    /// All names and values are stored in one buffer as `NAME=value` entries, each preceded by a null character,
+    /// and the index references them in place. Names are case-insensitive on Windows, like in the process
+    /// environment. On other platforms, the process environment is converted from UTF-8 for `wchar_t`.
+    /// </summary>
+    template <typename CHAR>
+    class Environment
+    {
+    public:
+        /// <summary>
+        /// Creates a snapshot from the entries of the form `NAME=value` in [`begin`, `end`).
+        /// Entries without `=` are ignored, and of several entries with the same name, the first one is used.
+        /// </summary>
+        template <typename IT>
+        Environment(IT begin, IT end)
+        {
+            for (; begin != end; ++begin)
+            {
+                const std::basic_string_view<CHAR> entry{*begin};
+                m_text.push_back(static_cast<CHAR>(0));
+                m_text.append(entry);
+            }
+            Index();
+        }
+
+        Environment(const Environment&) = delete;
+        Environment& operator=(const Environment&) = delete;
+
+        /// <summary>
+        /// Returns the snapshot of the process environment taken on the first call.
+        /// Later changes of the process environment are not visible in this snapshot, see `Capture`.
+        /// </summary>
+        static std::shared_ptr<const Environment> Process()
+        {
+            static const std::shared_ptr<const Environment> snapshot = Capture();
+            return snapshot;
+        }
+
+        /// <summary>
+        /// Takes a new snapshot of the process environment
+        /// </summary>
+        static std::shared_ptr<const Environment> Capture()
+        {
+            std::shared_ptr<Environment> env{new Environment{}};
+#ifdef _WIN32
+            if constexpr (sizeof(CHAR) == 1)
+            {
+                LPCH block = GetEnvironmentStringsA();
+                env->AppendBlock(reinterpret_cast<const CHAR*>(block));
+                FreeEnvironmentStringsA(block);
+            }
+            else
+            {
+                LPWCH block = GetEnvironmentStringsW();
+                env->AppendBlock(reinterpret_cast<const CHAR*>(block));
+                FreeEnvironmentStringsW(block);
+            }
+#else
+            for (char** entry = environ; entry != nullptr && *entry != nullptr; ++entry)
+            {
+                env->m_text.push_back(static_cast<CHAR>(0));
+                if constexpr (sizeof(CHAR) == 1)
+                {
+                    env->m_text.append(*entry);
+                }
+                else
+                {
+                    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(*entry);
+                    ResponseFile<CHAR>::DecodeUtf8(bytes, bytes + std::strlen(*entry), env->m_text);
+                }
+            }
+#endif
+            env->Index();
+            return env;
+        }
+
+        /// <summary>
+        /// Returns the value of the variable `name`, or nullopt if it is not set
+        /// </summary>
+        std::optional<std::basic_string_view<CHAR>> Find(std::basic_string_view<CHAR> name) const
+        {
+            auto it = m_variables.find(name);
+            if (it == m_variables.end())
+            {
+                return std::nullopt;
+            }
+            return it->second;
+        }
+
+        inline size_t Size() const noexcept
+        {
+            return m_variables.size();
+        }
+
+        /// <summary>
+        /// Returns the name of the variable of `value`, which must be a value returned by `Find`
+        /// </summary>
+        static std::basic_string_view<CHAR> NameOf(std::basic_string_view<CHAR> value) noexcept
+        {
+            // the value follows `NAME=`, which follows the null character separating the entries
+            const CHAR* end = value.data() - 1;
+            const CHAR* begin = end;
+            while (begin[-1] != static_cast<CHAR>(0))
+            {
+                --begin;
+            }
+            return std::basic_string_view<CHAR>{begin, static_cast<size_t>(end - begin)};
+        }
+
+    private:
+        struct NameHash
+        {
+            size_t operator()(std::basic_string_view<CHAR> name) const noexcept
+            {
+#ifdef _WIN32
+                size_t h = static_cast<size_t>(14695981039346656037ull);
+                for (CHAR c : name)
+                {
+                    h = (h ^ static_cast<size_t>(Alias<CHAR>::FoldCase(c))) * static_cast<size_t>(1099511628211ull);
+                }
+                return h;
+#else
+                return std::hash<std::basic_string_view<CHAR>>{}(name);
+#endif
+            }
+        };
+
+        struct NameEqual
+        {
+            bool operator()(std::basic_string_view<CHAR> a, std::basic_string_view<CHAR> b) const noexcept
+            {
+#ifdef _WIN32
+                return a.size() == b.size() &&
+                       std::equal(a.cbegin(), a.cend(), b.cbegin(),
+                                  [](CHAR x, CHAR y) { return Alias<CHAR>::FoldCase(x) == Alias<CHAR>::FoldCase(y); });
+#else
+                return a == b;
+#endif
+            }
+        };
+
+        Environment() noexcept = default;
+
+#ifdef _WIN32
+        /// <summary>
+        /// Appends the entries of a Windows environment block, which is terminated by an empty entry
+        /// </summary>
+        void AppendBlock(const CHAR* block)
+        {
+            if (block == nullptr)
+            {
+                return;
+            }
+            while (*block != static_cast<CHAR>(0))
+            {
+                const std::basic_string_view<CHAR> entry{block};
+                m_text.push_back(static_cast<CHAR>(0));
+                m_text.append(entry);
+                block += entry.size() + 1;
+            }
+        }
+#endif
+
+        /// <summary>
+        /// Builds the index of all entries in `m_text`, which must not change afterwards
+        /// </summary>
+        void Index()
+        {
+            // terminates the last entry, so that every value is followed by a null character, too
+            m_text.push_back(static_cast<CHAR>(0));
+            const std::basic_string_view<CHAR> text{m_text};
+            m_variables.reserve(static_cast<size_t>(std::count(text.cbegin(), text.cend(), static_cast<CHAR>(0))));
+            size_t pos = 1;
+            while (pos < text.size())
+            {
+                const size_t end = text.find(static_cast<CHAR>(0), pos);
+                // Windows keeps per-drive directories in entries like `=C:=C:\dir`, hence the name is not empty
+                const size_t eq = text.find(static_cast<CHAR>('='), pos + 1);
+                if (eq < end)
+                {
+                    m_variables.try_emplace(text.substr(pos, eq - pos), text.substr(eq + 1, end - eq - 1));
+                }
+                pos = end + 1;
+            }
+        }
+
+        std::basic_string<CHAR> m_text;
+        std::unordered_map<std::basic_string_view<CHAR>, std::basic_string_view<CHAR>, NameHash, NameEqual>
+            m_variables;
+    };
+
+    /// <summary>
+    /// A configuration file of `key = value` lines, which supplies values for Options and Switches missing from the
+    /// command line, see `Parser::AddConfigFile`.
+    /// Keys are the names of Options and Switches without leading `-` or `/`. Keys before the first `[section]`
+    /// header belong to the Parser, keys after a header to the Command of that path, i.e. the names of the Commands
+    /// from the top-level one to the nested one separated by `.`, e.g. `[remote.add]`. Lines starting with `#` or `;`
+    /// are comments. Keys and values are trimmed, and values can be quoted with `"` or `'`. A key without `=` has an
+    /// empty value, which sets a Switch. Repeated keys give multiple values.
+    /// Keys and values are views into the text, which is not copied.
+    /// </summary>
+    template <typename CHAR>
+    class ConfigFile
+    {
+    public:
+        static constexpr uint32_t npos = (std::numeric_limits<uint32_t>::max)();
+
+        /// <summary>
+        /// The section of the keys before the first section header
+        /// </summary>
+        static constexpr uint32_t rootSection = 0;
+
+        struct Entry
+        {
+            std::basic_string_view<CHAR> key;
+            std::basic_string_view<CHAR> value;
+            // one-based line number
+            int line;
+            // the next entry of the same section and key, ignoring case
+            uint32_t next;
+        };
+
+        /// <summary>
+        /// Parses `text`, which must outlive this object
+        /// </summary>
+        explicit ConfigFile(std::basic_string_view<CHAR> text)
+        {
+            Parse(text);
+        }
+
+        ConfigFile(const ConfigFile&) = delete;
+        ConfigFile& operator=(const ConfigFile&) = delete;
+
+        /// <summary>
+        /// Maps the file into memory and parses it. Returns nullptr if the file cannot be read.
+        /// The file is decoded like a response file, see `Parser::EnableResponseFiles`.
+        /// </summary>
+        static std::shared_ptr<const ConfigFile> Open(const std::filesystem::path& path)
+        {
+            std::shared_ptr<ResponseFile<CHAR>> file = ResponseFile<CHAR>::Open(path);
+            if (!file)
+            {
+                return nullptr;
+            }
+            std::shared_ptr<ConfigFile> config = std::make_shared<ConfigFile>(std::basic_string_view<CHAR>{
+                file->TextBegin(), static_cast<size_t>(file->TextEnd() - file->TextBegin())});
+            config->m_file = std::move(file);
+            return config;
+        }
+
+        /// <summary>
+        /// Returns the section of the Command path `pathBegin` to `pathEnd`, pointers to the Commands from the
+        /// top-level one to the nested one, or npos if the file has no section for it.
+        /// An empty path is the root section.
+        /// </summary>
+        template <typename IT>
+        uint32_t FindSection(IT pathBegin, IT pathEnd) const
+        {
+            if (pathBegin == pathEnd)
+            {
+                return rootSection;
+            }
+            for (size_t i = 1; i < m_sections.size(); ++i)
+            {
+                if (IsPathMatch(m_sections[i], pathBegin, pathEnd))
+                {
+                    return static_cast<uint32_t>(i);
+                }
+            }
+            return npos;
+        }
+
+        /// <summary>
+        /// Returns the first entry of `section` with the key `key`, ignoring case, or nullptr.
+        /// Use `Next` to iterate over all entries with this key in the order of the file.
+        /// </summary>
+        Entry const* FindFirst(uint32_t section, std::basic_string_view<CHAR> key) const
+        {
+            auto it = m_index.find(SectionKey{section, key});
+            return (it == m_index.end()) ? nullptr : &m_entries[it->second.first];
+        }
+
+        inline Entry const* Next(Entry const& entry) const noexcept
+        {
+            return (entry.next == npos) ? nullptr : &m_entries[entry.next];
+        }
+
+        inline std::vector<Entry> const& Entries() const noexcept
+        {
+            return m_entries;
+        }
+
+        /// <summary>
+        /// Returns the key of an Option or Switch name, i.e. the name without leading `-` or `/`
+        /// </summary>
+        static std::basic_string_view<CHAR> KeyOf(std::basic_string_view<CHAR> name) noexcept
+        {
+            const CHAR prefixes[] = {static_cast<CHAR>('-'), static_cast<CHAR>('/')};
+            const size_t start = name.find_first_not_of(prefixes, 0, 2);
+            return (start == std::basic_string_view<CHAR>::npos) ? std::basic_string_view<CHAR>{} : name.substr(start);
+        }
+
+    private:
+        struct SectionKey
+        {
+            uint32_t section;
+            std::basic_string_view<CHAR> key;
+        };
+
+        struct SectionKeyHash
+        {
+            size_t operator()(SectionKey const& k) const noexcept
+            {
+                size_t h = static_cast<size_t>(14695981039346656037ull) ^ k.section;
+                for (CHAR c : k.key)
+                {
+                    h = (h ^ static_cast<size_t>(Alias<CHAR>::FoldCase(c))) * static_cast<size_t>(1099511628211ull);
+                }
+                return h;
+            }
+        };
+
+        struct SectionKeyEqual
+        {
+            bool operator()(SectionKey const& a, SectionKey const& b) const noexcept
+            {
+                return a.section == b.section && a.key.size() == b.key.size() &&
+                       std::equal(a.key.cbegin(), a.key.cend(), b.key.cbegin(),
+                                  [](CHAR x, CHAR y) { return Alias<CHAR>::FoldCase(x) == Alias<CHAR>::FoldCase(y); });
+            }
+        };
+
+        struct Chain
+        {
+            uint32_t first;
+            uint32_t last;
+        };
+
+        static inline bool IsSpace(CHAR c) noexcept
+        {
+            return c == static_cast<CHAR>(' ') || (c >= static_cast<CHAR>('\t') && c <= static_cast<CHAR>('\r'));
+        }
+
+        static std::basic_string_view<CHAR> Trim(std::basic_string_view<CHAR> s) noexcept
+        {
+            while (!s.empty() && IsSpace(s.front()))
+            {
+                s.remove_prefix(1);
+            }
+            while (!s.empty() && IsSpace(s.back()))
+            {
+                s.remove_suffix(1);
+            }
+            return s;
+        }
+
+        template <typename IT>
+        static bool IsPathMatch(std::basic_string_view<CHAR> section, IT pathBegin, IT pathEnd)
+        {
+            for (IT it = pathBegin; it != pathEnd; ++it)
+            {
+                if (it != pathBegin)
+                {
+                    if (section.empty() || section.front() != static_cast<CHAR>('.'))
+                    {
+                        return false;
+                    }
+                    section.remove_prefix(1);
+                }
+                const size_t dot = section.find(static_cast<CHAR>('.'));
+                const std::basic_string_view<CHAR> name = Trim(section.substr(0, dot));
+                if (!static_cast<Command<CHAR> const*>(*it)->IsMatch(name))
+                {
+                    return false;
+                }
+                section.remove_prefix((dot == std::basic_string_view<CHAR>::npos) ? section.size() : dot);
+            }
+            return section.empty();
+        }
+
+        void Parse(std::basic_string_view<CHAR> text)
+        {
+            m_sections.push_back(std::basic_string_view<CHAR>{});
+            uint32_t section = rootSection;
+            int lineNumber = 0;
+            size_t pos = 0;
+            while (pos < text.size())
+            {
+                size_t end = text.find(static_cast<CHAR>('\n'), pos);
+                if (end == std::basic_string_view<CHAR>::npos)
+                {
+                    end = text.size();
+                }
+                const std::basic_string_view<CHAR> line = Trim(text.substr(pos, end - pos));
+                pos = end + 1;
+                ++lineNumber;
+
+                if (line.empty() || line.front() == static_cast<CHAR>('#') || line.front() == static_cast<CHAR>(';'))
+                {
+                    continue;
+                }
+                if (line.front() == static_cast<CHAR>('['))
+                {
+                    section = AddSection(Trim(line.substr(1, line.find(static_cast<CHAR>(']')) - 1)));
+                    continue;
+                }
+
+                const size_t eq = line.find(static_cast<CHAR>('='));
+                const std::basic_string_view<CHAR> key = Trim(line.substr(0, eq));
+                if (key.empty())
+                {
+                    continue;
+                }
+                std::basic_string_view<CHAR> value{line.data() + line.size(), 0};
+                if (eq != std::basic_string_view<CHAR>::npos)
+                {
+                    value = Trim(line.substr(eq + 1));
+                    if (value.size() >= 2 && value.front() == value.back() &&
+                        (value.front() == static_cast<CHAR>('"') || value.front() == static_cast<CHAR>('\'')))
+                    {
+                        value = value.substr(1, value.size() - 2);
+                    }
+                }
+                AddEntry(section, Entry{key, value, lineNumber, npos});
+            }
+        }
+
+        uint32_t AddSection(std::basic_string_view<CHAR> name)
+        {
+            if (name.empty())
+            {
+                return rootSection;
+            }
+            auto it = std::find(m_sections.cbegin() + 1, m_sections.cend(), name);
+            if (it != m_sections.cend())
+            {
+                return static_cast<uint32_t>(it - m_sections.cbegin());
+            }
+            m_sections.push_back(name);
+            return static_cast<uint32_t>(m_sections.size() - 1);
+        }
+
+        void AddEntry(uint32_t section, Entry const& entry)
+        {
+            const uint32_t index = static_cast<uint32_t>(m_entries.size());
+            m_entries.push_back(entry);
+            auto inserted = m_index.try_emplace(SectionKey{section, entry.key}, Chain{index, index});
+            if (!inserted.second)
+            {
+                m_entries[inserted.first->second.last].next = index;
+                inserted.first->second.last = index;
+            }
+        }
+
+        std::shared_ptr<ResponseFile<CHAR>> m_file;
+        std::vector<std::basic_string_view<CHAR>> m_sections;
+        std::vector<Entry> m_entries;
+        std::unordered_map<SectionKey, Chain, SectionKeyHash, SectionKeyEqual> m_index;
+    };
+
+    template <typename CHAR>
+    class Parser : public WithCommandContainer<CHAR>, public WithName<CHAR>, public WithDescription<CHAR>
+    {
+    public:
+        template <typename TSTR1, typename TSTR2>
+        Parser(const TSTR1& name, const TSTR2& description)
+            : WithCommandContainer<CHAR>{}, WithName<CHAR>{name}, WithDescription<CHAR>{description},
+              m_helpSwitch{Literal<CHAR>{StringConsts::helpName}, Literal<CHAR>{StringConsts::helpDescription}}
+        {
+            m_helpSwitch.AddAlias(Literal<CHAR>{StringConsts::helpAlias1})
+                .AddAlias(Literal<CHAR>{StringConsts::helpAlias2})
+                .AddAlias(Literal<CHAR>{StringConsts::helpAlias3})
+                .AddAlias(Literal<CHAR>{StringConsts::helpAlias4});
+        }
+
+        Parser& AddCommand(const Command<CHAR>& command)
+        {
+            WithCommandContainer<CHAR>::AddCommandImpl(command);
+            m_helpCache.Clear();
+            return *this;
+        }
+
+        Parser& AddOption(const Option<CHAR>& option)
+        {
+            WithCommandContainer<CHAR>::AddOptionImpl(option);
+            m_helpCache.Clear();
+            return *this;
+        }
+
+        Parser& AddSwitch(const Switch<CHAR>& switchOption)
+        {
+            WithCommandContainer<CHAR>::AddSwitchImpl(switchOption);
+            m_helpCache.Clear();
+            return *this;
+        }
+
+        Parser& AddArgument(const Argument<CHAR>& argument)
         {
             WithCommandContainer<CHAR>::AddArgumentImpl(argument);
+            m_helpCache.Clear();
             return *this;
         }
 
@@ -662,9 +3052,10 @@ namespace yaclap
             return AddArgument(argument);
         }
 
-        inline void EnableImplicitHelpSwitch(bool enable = true) noexcept
+        inline void EnableImplicitHelpSwitch(bool enable = true)
         {
             m_withImplicitHelpSwitch = enable;
+            m_helpCache.Clear();
         }
 
         inline bool IsImplicitHelpSwitchEnabled() const noexcept
@@ -682,9 +3073,76 @@ namespace yaclap
             return m_errorOnUnmatchedArguments;
         }
 
+        /// <summary>
+        /// Enables expanding arguments of the form `@file` with the arguments read from the response file `file`.
+        /// Response files can reference further response files. The expanded arguments point directly into the
+        /// memory-mapped files, which are kept alive by the Result. All expanded arguments report the position of
+        /// the `@file` argument in the command line.
+        /// </summary>
+        inline void EnableResponseFiles(bool enable = true) noexcept
+        {
+            m_withResponseFiles = enable;
+        }
+
+        inline bool IsResponseFilesEnabled() const noexcept
+        {
+            return m_withResponseFiles;
+        }
+
+        /// <summary>
+        /// Sets the environment from which Options and Switches declared with `FromEnvironment` take their values if
+        /// they are missing from the command line. If not set, `Environment::Process()` is used, the snapshot of the
+        /// process environment taken once on first use.
+        /// </summary>
+        inline void SetEnvironment(std::shared_ptr<const Environment<CHAR>> environment) noexcept
+        {
+            m_environment = std::move(environment);
+        }
+
+        inline std::shared_ptr<const Environment<CHAR>> const& GetEnvironment() const noexcept
+        {
+            return m_environment;
+        }
+
+        /// <summary>
+        /// Adds a config file, from which Options and Switches take their values if they are missing from the command
+        /// line and the environment. Files added later take precedence over files added earlier, and the values of
+        /// an Option or Switch are all taken from the file with the highest precedence having any.
+        /// The Result references the values in the file, and keeps it alive.
+        /// A null `configFile` is ignored, so the result of `ConfigFile::Open` for an optional file, which might not
+        /// exist, can be added directly.
+        /// </summary>
+        Parser& AddConfigFile(std::shared_ptr<const ConfigFile<CHAR>> configFile)
+        {
+            if (configFile)
+            {
+                m_configFiles.push_back(std::move(configFile));
+            }
+            return *this;
+        }
+
+        inline void ClearConfigFiles() noexcept
+        {
+            m_configFiles.clear();
+        }
+
+        inline std::vector<std::shared_ptr<const ConfigFile<CHAR>>> const& ConfigFiles() const noexcept
+        {
+            return m_configFiles;
+        }
+
+        class ResultValueView;
+
         class ResultErrorInfo
         {
         public:
+            ResultErrorInfo() = default;
+
+            explicit ResultErrorInfo(std::pmr::memory_resource* memory)
+                : m_conversions{memory}
+            {
+            }
+
             /// <summary>
             /// Returns true if this is the Result of a successful parsing,
             /// i.e. no errors were encountered, and the implicit help switch was not triggered.
@@ -707,14 +3165,13 @@ namespace yaclap
             /// </summary>
             inline void SetError(const CHAR* message, bool setUnsuccessful = true)
             {
-                if (m_error.empty() && (message != nullptr || *message != static_cast<CHAR>(0)))
+                if (m_error.empty() && (message != nullptr && *message != static_cast<CHAR>(0)))
                 {
                     m_error = message;
                 }
                 if (setUnsuccessful)
                 {
-                    m_success = false;
-                    m_shouldShowHelp = true;
+                    SetUnsuccessful();
                 }
             }
 
@@ -746,17 +3203,124 @@ namespace yaclap
                 m_error.clear();
             }
 
+            /// <summary>
+            /// Marks the Result as unsuccessful without changing the error message
+            /// </summary>
+            inline void SetUnsuccessful() noexcept
+            {
+                m_success = false;
+                m_shouldShowHelp = true;
+            }
+
+            /// <summary>
+            /// Resets to the initial state, keeping the memory of the error message
+            /// </summary>
+            inline void Reset() noexcept
+            {
+                m_success = false;
+                m_shouldShowHelp = false;
+                m_error.clear();
+                m_conversions.clear();
+            }
+
         private:
+            friend class ResultValueView;
+
+            /// <summary>
+            /// The results of the conversions already performed on one value of the Result, including errors
+            /// </summary>
+            struct Conversions
+            {
+                using Status = typename NumberParser<CHAR>::Status;
+
+                enum Flags : uint8_t
+                {
+                    Integer = 1,
+                    Double = 2,
+                    Float = 4,
+                    Bool = 8
+                };
+
+                template <typename T>
+                struct Floating
+                {
+                    Status status;
+                    T value;
+                    size_t errorAt;
+                };
+
+                uint8_t done{0};
+                typename NumberParser<CHAR>::IntegerParts integer;
+                Floating<double> asDouble;
+                Floating<float> asFloat;
+                Status boolStatus;
+                bool boolValue;
+
+                template <typename T>
+                inline Floating<T>& Get() noexcept
+                {
+                    if constexpr (std::is_same_v<T, float>)
+                    {
+                        return asFloat;
+                    }
+                    else
+                    {
+                        return asDouble;
+                    }
+                }
+            };
+
+            inline Conversions& GetConversions(uint32_t slot)
+            {
+                if (slot >= m_conversions.size())
+                {
+                    m_conversions.resize(static_cast<size_t>(slot) + 1);
+                }
+                return m_conversions[slot];
+            }
+
             bool m_success = false;
             bool m_shouldShowHelp = false;
             std::basic_string<CHAR> m_error{};
+            // indexed by the cache slot of the values
+            std::pmr::vector<Conversions> m_conversions;
+        };
+
+        /// <summary>
+        /// Where the value of a ResultValueView came from
+        /// </summary>
+        enum class ValueOrigin
+        {
+            /// The view has no value
+            None,
+            /// An argument of the command line, or of a response file
+            CommandLine,
+            /// An environment variable, see `Option::FromEnvironment`
+            Environment,
+            /// A key of a config file, see `Parser::AddConfigFile`
+            ConfigFile
         };
 
+        /// <summary>
+        /// A value string of a parse Result.
+        /// Conversion errors are reported to the error state of the Result the view was created by. The view, and all
+        /// its copies, only reference that state without owning it, so the Result must outlive all views used for
+        /// conversions, e.g. `parser.Parse(argc, argv).GetOptionValue(opt).AsInteger()` is fine, but keeping the
+        /// view beyond the statement is not. Views without value, e.g. when a queried Option was not present, do not
+        /// report conversion errors.
+        /// The results of conversions, values and errors, are cached in the Result, so repeated conversions of the same
+        /// value, also through copies of the view, only parse the string once. Every conversion, also a successful
+        /// one, writes to that cache, which is why the lifetime rule applies to all conversions, and why conversions
+        /// of values of the same Result must not run concurrently.
+        /// </summary>
         class ResultValueView : public std::basic_string_view<CHAR>
         {
         public:
-            ResultValueView()
-                : m_errorInfo{std::make_shared<ResultErrorInfo>()}, m_source{std::nullopt}, m_position{-1}
+            static constexpr uint32_t noCacheSlot = (std::numeric_limits<uint32_t>::max)();
+
+            ResultValueView() noexcept
+                : m_errorInfo{nullptr}, m_source{std::nullopt}, m_position{-1}, m_cacheSlot{noCacheSlot},
+                  m_origin{ValueOrigin::None}
             {
             }
 
@@ -764,6 +3328,10 @@ namespace yaclap
 
             ResultValueView(ResultValueView&& src) = default;
 
+            ResultValueView& operator=(ResultValueView const& src) = default;
+
+            ResultValueView& operator=(ResultValueView&& src) = default;
+
             inline std::optional<WithIdentity<CHAR>> const& GetSource() const noexcept
             {
                 return m_source;
@@ -780,7 +3348,15 @@ namespace yaclap
 
             inline bool HasValue() const noexcept
             {
-                return m_position >= 0;
+                return m_origin != ValueOrigin::None;
+            }
+
+            /// <summary>
+            /// Returns where the value came from. Values from the command line take precedence over all others.
+            /// </summary>
+            inline ValueOrigin GetOrigin() const noexcept
+            {
+                return m_origin;
             }
 
             inline operator bool() const noexcept
@@ -788,6 +3364,10 @@ namespace yaclap
                 return HasValue();
             }
 
+            /// <summary>
+            /// Returns the position of the value in the command line, the one-based line number for values from a
+            /// config file, or -1 for values from the environment
+            /// </summary>
             inline int GetPosition() const noexcept
             {
                 return m_position;
@@ -809,7 +3389,46 @@ namespace yaclap
             ///     [+-]?[bB][0..1]+
             ///   Optional sign, 'b' marker, followed by binary-number characters in base-2
             /// </remarks>
-            std::optional<long long> AsInteger(bool errorWhenTypeParingFails = true) const;
+            std::optional<long long> AsInteger(bool errorWhenTypeParingFails = true) const
+            {
+                return ConvertInteger<long long>(errorWhenTypeParingFails);
+            }
+
+            /// <summary>
+            /// Converts the value into a signed 32 bit integer, with the syntax of AsInteger.
+            /// Values outside of the range of the type are reported as errors.
+            /// </summary>
+            std::optional<int32_t> AsInt32(bool errorWhenTypeParingFails = true) const
+            {
+                return ConvertInteger<int32_t>(errorWhenTypeParingFails);
+            }
+
+            /// <summary>
+            /// Converts the value into a signed 64 bit integer, with the syntax of AsInteger.
+            /// Values outside of the range of the type are reported as errors.
+            /// </summary>
+            std::optional<int64_t> AsInt64(bool errorWhenTypeParingFails = true) const
+            {
+                return ConvertInteger<int64_t>(errorWhenTypeParingFails);
+            }
+
+            /// <summary>
+            /// Converts the value into an unsigned 32 bit integer, with the syntax of AsInteger.
+            /// Values outside of the range of the type, including negative values, are reported as errors.
+            /// </summary>
+            std::optional<uint32_t> AsUInt32(bool errorWhenTypeParingFails = true) const
+            {
+                return ConvertInteger<uint32_t>(errorWhenTypeParingFails);
+            }
+
+            /// <summary>
+            /// Converts the value into an unsigned 64 bit integer, with the syntax of AsInteger.
+            /// Values outside of the range of the type, including negative values, are reported as errors.
+            /// </summary>
+            std::optional<uint64_t> AsUInt64(bool errorWhenTypeParingFails = true) const
+            {
+                return ConvertInteger<uint64_t>(errorWhenTypeParingFails);
+            }
 
             /// <summary>
             /// Converts a string optional return from this result into a floating-point (64bit double) optional.
@@ -824,7 +3443,19 @@ namespace yaclap
             ///   must start with the dot. Sign character is optional. Exponent must start with the e-marker. Exponent
             ///   is optional. Exponent sign is optional.
             /// </remarks>
-            std::optional<double> AsDouble(bool errorWhenTypeParingFails = true) const;
+            std::optional<double> AsDouble(bool errorWhenTypeParingFails = true) const
+            {
+                return ConvertFloat<double>(errorWhenTypeParingFails);
+            }
+
+            /// <summary>
+            /// Converts the value into a floating-point (32bit float) optional, with the syntax of AsDouble.
+            /// The value is rounded correctly to float directly, not via double.
+            /// </summary>
+            std::optional<float> AsFloat(bool errorWhenTypeParingFails = true) const
+            {
+                return ConvertFloat<float>(errorWhenTypeParingFails);
+            }
 
             /// <summary>
             /// Converts a string optional return from this result into a boolean (bool) optional.
@@ -844,10 +3475,93 @@ namespace yaclap
             /// </remarks>
             std::optional<bool> AsBool(bool errorWhenTypeParingFails = true) const;
 
+            /// <summary>
+            /// Splits the value into the elements of a list, separated by `delimiter`, e.g. `1,2,3`.
+            /// The elements are views into the value and are found while iterating, without allocating memory.
+            /// </summary>
+            inline ValueList<CHAR> Split(CHAR delimiter = static_cast<CHAR>(',')) const noexcept
+            {
+                return ValueList<CHAR>{*this, delimiter};
+            }
+
+            /// <summary>
+            /// Converts the elements of the list value, separated by `delimiter`, into integers stored in `out`, each
+            /// with the syntax of AsInteger and the range of `T`. Returns the number of elements.
+            /// If an element cannot be converted, or there are more than `capacity` elements, an error including the
+            /// one-based index of the element is set on the Result, unless deactivated with the optional bool
+            /// parameter, and the function returns a null optional. `Split(delimiter).size()` returns the number of
+            /// elements to allocate the buffer.
+            /// </summary>
+            template <typename T>
+            std::optional<size_t> AsIntegerList(T* out, size_t capacity, CHAR delimiter = static_cast<CHAR>(','),
+                                                bool errorWhenTypeParingFails = true) const
+            {
+                return ConvertList(out, capacity, delimiter, errorWhenTypeParingFails);
+            }
+
+            /// <summary>
+            /// Converts the elements of the list value, separated by `delimiter`, into doubles stored in `out`, each
+            /// with the syntax of AsDouble. Returns the number of elements, with the same error handling as
+            /// AsIntegerList.
+            /// </summary>
+            std::optional<size_t> AsDoubleList(double* out, size_t capacity, CHAR delimiter = static_cast<CHAR>(','),
+                                               bool errorWhenTypeParingFails = true) const
+            {
+                return ConvertList(out, capacity, delimiter, errorWhenTypeParingFails);
+            }
+
+            /// <summary>
+            /// Converts a range list value into a set of unsigned integers, e.g. for CPU or shard masks.
+            /// If the string cannot be parsed and converted, or a value is larger than `maxValue`, an error including
+            /// the one-based index of the failing element is set on the Result, unless deactivated with the optional
+            /// bool parameter, and the function will return a null optional.
+            /// </summary>
+            /// <remarks>
+            /// Syntax:
+            ///     (int)(-(int))?(,(int)(-(int))?)*
+            ///   Elements separated by `delimiter`, each a single value or a closed range of values. The values are
+            ///   unsigned and use the syntax of AsInteger, including its base prefixes, e.g. `0-3,8-15,x20-x3F`.
+            ///   Overlapping and adjacent ranges are merged.
+            /// </remarks>
+            std::optional<RangeList> AsRangeList(uint64_t maxValue = (std::numeric_limits<uint64_t>::max)(),
+                                                 CHAR delimiter = static_cast<CHAR>(','),
+                                                 bool errorWhenTypeParingFails = true) const;
+
+            /// <summary>
+            /// Converts the value into `T`, which can be `bool` (cf. AsBool), any integer type (cf. AsInteger, with the
+            /// range of `T`), `float` or `double` (cf. AsDouble), or the string types `std::basic_string<CHAR>` and
+            /// `std::basic_string_view<CHAR>`, which are not converted.
+            /// </summary>
+            template <typename T>
+            std::optional<T> As(bool errorWhenTypeParingFails = true) const
+            {
+                if constexpr (std::is_same_v<T, bool>)
+                {
+                    return AsBool(errorWhenTypeParingFails);
+                }
+                else if constexpr (std::is_integral_v<T>)
+                {
+                    return ConvertInteger<T>(errorWhenTypeParingFails);
+                }
+                else if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>)
+                {
+                    return ConvertFloat<T>(errorWhenTypeParingFails);
+                }
+                else
+                {
+                    static_assert(std::is_same_v<T, std::basic_string<CHAR>> ||
+                                      std::is_same_v<T, std::basic_string_view<CHAR>>,
+                                  "unsupported value type");
+                    return T{static_cast<std::basic_string_view<CHAR> const&>(*this)};
+                }
+            }
+
         protected:
-            ResultValueView(std::basic_string_view<CHAR> str, std::shared_ptr<ResultErrorInfo> errorInfo,
-                            std::optional<WithIdentity<CHAR>> source, int position)
-                : std::basic_string_view<CHAR>{str}, m_errorInfo{errorInfo}, m_source{source}, m_position{position}
+            ResultValueView(std::basic_string_view<CHAR> str, ResultErrorInfo* errorInfo,
+                            std::optional<WithIdentity<CHAR>> source, int position, uint32_t cacheSlot,
+                            ValueOrigin origin)
+                : std::basic_string_view<CHAR>{str}, m_errorInfo{errorInfo}, m_source{source}, m_position{position},
+                  m_cacheSlot{cacheSlot}, m_origin{origin}
             {
             }
 
@@ -872,9 +3586,144 @@ namespace yaclap
                 return std::make_pair(b, e);
             }
 
-            std::shared_ptr<ResultErrorInfo> m_errorInfo;
+            template <typename T>
+            std::optional<T> ConvertInteger(bool errorWhenTypeParingFails) const;
+
+            template <typename T>
+            std::optional<T> ConvertFloat(bool errorWhenTypeParingFails) const;
+
+            typename NumberParser<CHAR>::Status ParseBool(bool& value) const;
+
+            template <typename T>
+            std::optional<size_t> ConvertList(T* out, size_t capacity, CHAR delimiter,
+                                              bool errorWhenTypeParingFails) const;
+
+            /// <summary>
+            /// Returns the cached conversions of this value, or nullptr if the view has no cache slot.
+            /// The cache is logically part of the value, so it is grown on first use, even though this is `const`.
+            /// </summary>
+            inline typename ResultErrorInfo::Conversions* GetConversions() const
+            {
+                if (m_errorInfo == nullptr || m_cacheSlot == noCacheSlot)
+                {
+                    return nullptr;
+                }
+                return &m_errorInfo->GetConversions(m_cacheSlot);
+            }
+
+            /// <summary>
+            /// Reports a conversion error, only building the message if it is actually reported.
+            /// `charPos` is the one-based position of an unexpected character, if `reason` requires it.
+            /// `element` is the one-based index of the failing element of a list value.
+            /// </summary>
+            void ReportConversionError(bool errorWhenTypeParingFails, const CHAR* reason, size_t charPos = 0,
+                                       size_t element = 0) const
+            {
+                if (!errorWhenTypeParingFails || m_errorInfo == nullptr)
+                {
+                    return;
+                }
+                if (!m_errorInfo->GetError().empty())
+                {
+                    // only the first error message is kept
+                    m_errorInfo->SetUnsuccessful();
+                    return;
+                }
+                std::basic_string<CHAR> msg;
+                if (m_origin == ValueOrigin::Environment)
+                {
+                    msg = StringConsts::errorEnvironmentValueConversion;
+                    msg += Environment<CHAR>::NameOf(*this);
+                }
+                else if (m_origin == ValueOrigin::ConfigFile)
+                {
+                    msg = StringConsts::errorConfigFileValueConversion;
+                    msg += StringConsts::to_string(GetPosition());
+                }
+                else
+                {
+                    msg = StringConsts::errorParserValueConversion;
+                    msg += StringConsts::to_string(GetPosition());
+                }
+                msg += StringConsts::errorContextSeparator;
+                if (element > 0)
+                {
+                    msg += StringConsts::errorListElement;
+                    msg += StringConsts::to_string(element);
+                    msg += StringConsts::errorContextSeparator;
+                }
+                msg += reason;
+                if (charPos > 0)
+                {
+                    msg += StringConsts::to_string(charPos);
+                }
+                ReportError(msg);
+            }
+
+            inline void ReportError(std::basic_string<CHAR> const& msg) const
+            {
+                if (m_errorInfo != nullptr)
+                {
+                    m_errorInfo->SetError(msg);
+                }
+            }
+
+            ResultErrorInfo* m_errorInfo;
             std::optional<WithIdentity<CHAR>> m_source;
             int m_position;
+            uint32_t m_cacheSlot;
+            ValueOrigin m_origin;
+        };
+
+        /// <summary>
+        /// A contiguous range of ResultValueView objects stored in a parse Result
+        /// </summary>
+        class ResultValueRange
+        {
+        public:
+            ResultValueRange() noexcept = default;
+
+            ResultValueRange(ResultValueView const* first, size_t count) noexcept
+                : m_begin{first}, m_end{first + count}
+            {
+            }
+
+            inline ResultValueView const* begin() const noexcept
+            {
+                return m_begin;
+            }
+
+            inline ResultValueView const* end() const noexcept
+            {
+                return m_end;
+            }
+
+            inline size_t size() const noexcept
+            {
+                return static_cast<size_t>(m_end - m_begin);
+            }
+
+            inline bool empty() const noexcept
+            {
+                return m_begin == m_end;
+            }
+
+            inline ResultValueView const& operator[](size_t i) const noexcept
+            {
+                return m_begin[i];
+            }
+
+            /// <summary>
+            /// Copies the values into a vector, e.g. for code storing the result of `Result::GetOptionValues`
+            /// </summary>
+            inline operator std::vector<ResultValueView>() const
+            {
+                return std::vector<ResultValueView>(m_begin, m_end);
+            }
+
+        private:
+            ResultValueView const* m_begin{nullptr};
+            ResultValueView const* m_end{nullptr};
         };
 
         /// <summary>
@@ -941,10 +3790,19 @@ namespace yaclap
 
             /// <summary>
             /// Returns all Commands occured in the command line in order in which they appeared.
+            /// Empty for Results parsed with a memory resource, which store them in `PmrCommands`.
             /// </summary>
             inline std::vector<WithIdentity<CHAR>> const& Commands() const noexcept
             {
-                return m_commands;
+                return m_commands.Std();
+            }
+
+            /// <summary>
+            /// Returns all Commands of a Result parsed with a memory resource, see `Commands`
+            /// </summary>
+            inline std::pmr::vector<WithIdentity<CHAR>> const& PmrCommands() const noexcept
+            {
+                return m_commands.Pmr();
             }
 
             /// <summary>
@@ -952,46 +3810,43 @@ namespace yaclap
             /// </summary>
             inline bool HasCommand(Command<CHAR> const& cmd) const noexcept
             {
-                for (auto const& cmdId : m_commands)
-                {
-                    if (WithIdentity<CHAR>::Equals(cmdId, cmd))
-                    {
-                        return true;
-                    }
-                }
-                return false;
+                return FindIndexSlot(cmd) != nullptr;
             }
 
             /// <summary>
             /// Returns all Options occured in the command line in order in which they appeared.
+            /// Empty for Results parsed with a memory resource, which store them in `PmrOptions`.
             /// </summary>
             inline std::vector<ResultValueView> const& Options() const noexcept
             {
-                return m_options;
+                return m_options.Std();
+            }
+
+            /// <summary>
+            /// Returns all Options of a Result parsed with a memory resource, see `Options`
+            /// </summary>
+            inline std::pmr::vector<ResultValueView> const& PmrOptions() const noexcept
+            {
+                return m_options.Pmr();
             }
 
             /// <summary>
             /// Returns the number of times the specified option `opt` was seen in the command line (0 = never).
             /// </summary>
-            inline size_t GetOptionCount(Option<CHAR> const& opt) const
+            inline size_t GetOptionCount(Option<CHAR> const& opt) const noexcept
             {
-                return std::count_if(m_options.cbegin(), m_options.cend(),
-                                     [&opt](ResultValueView const& o) { return o.IsFromSource(opt); });
+                IndexSlot const* slot = FindIndexSlot(opt);
+                return (slot == nullptr) ? 0 : slot->count;
             }
 
             /// <summary>
             /// Returns the value of the _first_ occurance of the specified Option `opt` in the command line.
+            /// The returned view references this Result, which must outlive it, see ResultValueView.
             /// </summary>
             inline ResultValueView GetOptionValue(Option<CHAR> const& opt) const
             {
-                for (ResultValueView const& o : m_options)
-                {
-                    if (o.IsFromSource(opt))
-                    {
-                        return o;
-                    }
-                }
-                return {};
+                IndexSlot const* slot = FindIndexSlot(opt);
+                return (slot == nullptr) ? ResultValueView{} : m_optionsBySource[slot->first];
             }
 
             /// <summary>
@@ -1003,137 +3858,384 @@ namespace yaclap
             /// Returns the value of the _first_ occurance of the specified Option `opt` in the command line.
             /// If `setErrorIfMultiple` is set to `ErrorIfMultiple` or `true`, and the Option was found more than one
             /// time in the command line, then an error message is set in the result object, and `nullopt` is returned.
+            /// The returned view references this Result, which must outlive it, see ResultValueView.
             /// </summary>
             inline ResultValueView GetOptionValue(Option<CHAR> const& opt, bool setErrorIfMultiple)
             {
-                if (GetOptionCount(opt) > 1)
-                {
-                    m_errorInfo->SetError(string_t{StringConsts::errorOptionSpecifiedMultipletimes} +
-                                          opt.NameAliasBegin()->GetName());
-                    return {};
-                }
-                return GetOptionValue(opt);
+                IndexSlot const* slot = FindIndexSlot(opt);
+                if (slot == nullptr)
+                {
+                    return {};
+                }
+                if (slot->count > 1)
+                {
+                    m_errorInfo->SetError(string_t{StringConsts::errorOptionSpecifiedMultipletimes}.append(
+                        opt.NameAliasBegin()->GetNameView()));
+                    return {};
+                }
+                return m_optionsBySource[slot->first];
+            }
+
+            /// <summary>
+            /// Returns all values of all occurances of the specified Option `opt` in the command line, in the order in
+            /// which they appeared. The returned range references the values stored in this result object, and converts
+            /// to a `std::vector<ResultValueView>` copy of them.
+            /// </summary>
+            inline ResultValueRange GetOptionValues(Option<CHAR> const& opt) const noexcept
+            {
+                IndexSlot const* slot = FindIndexSlot(opt);
+                if (slot == nullptr)
+                {
+                    return {};
+                }
+                return ResultValueRange{m_optionsBySource.data() + slot->first, slot->count};
+            }
+
+            /// <summary>
+            /// Returns all Switches occured in the command line in the order in which they appeared.
+            /// Empty for Results parsed with a memory resource, which store them in `PmrSwitches`.
+            /// </summary>
+            inline std::vector<WithIdentity<CHAR>> const& Switches() const noexcept
+            {
+                return m_switches.Std();
+            }
+
+            /// <summary>
+            /// Returns all Switches of a Result parsed with a memory resource, see `Switches`
+            /// </summary>
+            inline std::pmr::vector<WithIdentity<CHAR>> const& PmrSwitches() const noexcept
+            {
+                return m_switches.Pmr();
+            }
+
+            /// <summary>
+            /// Returns the number of times the specified switch `swt` was seen in the command line (0 = never).
+            /// </summary>
+            inline size_t HasSwitch(Switch<CHAR> const& swt) const noexcept
+            {
+                IndexSlot const* slot = FindIndexSlot(swt);
+                return (slot == nullptr) ? 0 : slot->count;
+            }
+
+            /// <summary>
+            /// Returns all matched Arguments occured in the command line in the order in which they appeared.
+            /// Empty for Results parsed with a memory resource, which store them in `PmrMatchedArguments`.
+            /// </summary>
+            inline std::vector<ResultValueView> const& MatchedArguments() const noexcept
+            {
+                return m_matchedArguments.Std();
+            }
+
+            /// <summary>
+            /// Returns all matched Arguments of a Result parsed with a memory resource, see `MatchedArguments`
+            /// </summary>
+            inline std::pmr::vector<ResultValueView> const& PmrMatchedArguments() const noexcept
+            {
+                return m_matchedArguments.Pmr();
+            }
+
+            /// <summary>
+            /// Gets the value of the specified Argument `arg`.
+            /// The returned view references this Result, which must outlive it, see ResultValueView.
+            /// </summary>
+            inline ResultValueView GetArgument(Argument<CHAR> const& arg) const
+            {
+                IndexSlot const* slot = FindIndexSlot(arg);
+                return (slot == nullptr) ? ResultValueView{} : m_matchedArguments[slot->first];
+            }
+
+            /// <summary>
+            /// Returns all unmatched arguments from the command line.
+            /// Empty for Results parsed with a memory resource, which store them in `PmrUnmatchedArguments`.
+            /// </summary>
+            inline std::vector<ResultValueView> const& UnmatchedArguments() const noexcept
+            {
+                return m_unmatchedArguments.Std();
+            }
+
+            /// <summary>
+            /// Returns all unmatched arguments of a Result parsed with a memory resource, see `UnmatchedArguments`
+            /// </summary>
+            inline std::pmr::vector<ResultValueView> const& PmrUnmatchedArguments() const noexcept
+            {
+                return m_unmatchedArguments.Pmr();
+            }
+
+            /// <summary>
+            /// Returns true if there is at least one unmatched argument.
+            /// </summary>
+            inline bool HasUnmatchedArguments() const noexcept
+            {
+                return !m_unmatchedArguments.empty();
+            }
+
+        protected:
+            /// <summary>
+            /// Creates an empty Result. With `memory` being nullptr, the entries are stored in std::vectors, otherwise
+            /// all memory is allocated from `memory`.
+            /// </summary>
+            explicit Result(std::pmr::memory_resource* memory)
+                : m_errorInfo{std::allocate_shared<ResultErrorInfo>(
+                      std::pmr::polymorphic_allocator<ResultErrorInfo>{ResourceOrDefault(memory)},
+                      ResourceOrDefault(memory))},
+                  m_commands{memory}, m_options{memory}, m_switches{memory}, m_matchedArguments{memory},
+                  m_unmatchedArguments{memory}, m_optionsBySource{ResourceOrDefault(memory)},
+                  m_index{ResourceOrDefault(memory)}, m_storage{ResourceOrDefault(memory)}
+            {
+            }
+
+            inline void AddCommand(Command<CHAR> const& cmd)
+            {
+                m_commands.push_back(WithIdentity<CHAR>{cmd});
+            }
+
+            inline void AddOption(ResultValueView&& rv)
+            {
+                m_options.push_back(std::move(rv));
+            }
+
+            inline void AddSwitch(Switch<CHAR> const& swt)
+            {
+                m_switches.push_back(WithIdentity<CHAR>{swt});
+            }
+
+            inline void AddMatchedArgument(ResultValueView&& rv)
+            {
+                m_matchedArguments.push_back(std::move(rv));
+            }
+
+            inline void AddUnmatchedArgument(ResultValueView&& rv)
+            {
+                m_unmatchedArguments.push_back(std::move(rv));
             }
 
-            /// <summary>
-            /// Returns all values of all occurances of the specified Option `opt` in the command line.
-            /// </summary>
-            inline std::vector<ResultValueView> GetOptionValues(Option<CHAR> const& opt) const
+            inline ResultErrorInfo* GetErrorInfo() noexcept
             {
-                std::vector<ResultValueView> result;
-                for (ResultValueView const& o : m_options)
-                {
-                    if (o.IsFromSource(opt))
-                    {
-                        result.push_back(o);
-                    }
-                }
-                return result;
+                return m_errorInfo.get();
             }
 
             /// <summary>
-            /// Returns all Switches occured in the command line in the order in which they appeared
+            /// Keeps `storage` alive as long as this Result, e.g. the memory values are pointing into
             /// </summary>
-            inline std::vector<WithIdentity<CHAR>> const& Switches() const noexcept
+            inline void AddStorage(std::shared_ptr<const void> storage)
             {
-                return m_switches;
+                m_storage.push_back(std::move(storage));
             }
 
             /// <summary>
-            /// Returns the number of times the specified switch `swt` was seen in the command line (0 = never).
+            /// Removes all entries and resets the error state, keeping the allocated memory for reuse
             /// </summary>
-            inline size_t HasSwitch(Switch<CHAR> const& swt) const
+            void Clear() noexcept
             {
-                return std::count_if(m_switches.cbegin(), m_switches.cend(), [&swt](WithIdentity<CHAR> const& s)
-                                     { return WithIdentity<CHAR>::Equals(s, swt); });
+                m_errorInfo->Reset();
+                m_commands.clear();
+                m_options.clear();
+                m_switches.clear();
+                m_matchedArguments.clear();
+                m_unmatchedArguments.clear();
+                m_optionsBySource.clear();
+                m_index.clear();
+                m_storage.clear();
             }
 
             /// <summary>
-            /// Returns all matched Arguments occured in the command line in the order in which they appeared
+            /// Builds the index from the identities of Commands, Options, Switches, and Arguments to their entries.
+            /// Must be called after all entries have been added, and before the result is queried.
             /// </summary>
-            inline std::vector<ResultValueView> const& MatchedArguments() const noexcept
-            {
-                return m_matchedArguments;
-            }
+            void BuildIndex();
 
+        private:
             /// <summary>
-            /// Gets the value of the specified Argument `arg`
+            /// The entries of one kind, stored in a std::vector, or in a std::pmr::vector for Results parsed with a
+            /// memory resource
             /// </summary>
-            inline ResultValueView GetArgument(Argument<CHAR> const& arg) const
+            template <typename T>
+            class Entries
             {
-                for (auto const& matched : m_matchedArguments)
+            public:
+                explicit Entries(std::pmr::memory_resource* memory)
+                    : m_pmr{ResourceOrDefault(memory)}, m_usePmr{memory != nullptr}
+                {
+                }
+
+                inline std::vector<T> const& Std() const noexcept
+                {
+                    return m_std;
+                }
+
+                inline std::pmr::vector<T> const& Pmr() const noexcept
+                {
+                    return m_pmr;
+                }
+
+                inline void push_back(T&& value)
                 {
-                    if (matched.IsFromSource(arg))
+                    if (m_usePmr)
+                    {
+                        m_pmr.push_back(std::move(value));
+                    }
+                    else
                     {
-                        return matched;
+                        m_std.push_back(std::move(value));
                     }
                 }
-                return {};
-            }
 
-            /// <summary>
-            /// Returns all unmatched arguments from the command line.
-            /// </summary>
-            inline std::vector<ResultValueView> const& UnmatchedArguments() const noexcept
-            {
-                return m_unmatchedArguments;
-            }
+                inline void clear() noexcept
+                {
+                    m_std.clear();
+                    m_pmr.clear();
+                }
 
-            /// <summary>
-            /// Returns true if there is at least one unmatched argument.
-            /// </summary>
-            inline bool HasUnmatchedArguments() const noexcept
-            {
-                return !m_unmatchedArguments.empty();
-            }
+                inline T const* begin() const noexcept
+                {
+                    return m_usePmr ? m_pmr.data() : m_std.data();
+                }
 
-        protected:
-            Result() = default;
+                inline T const* end() const noexcept
+                {
+                    return begin() + size();
+                }
 
-            inline void AddCommand(Command<CHAR> const& cmd)
-            {
-                m_commands.push_back(cmd);
-            }
+                inline size_t size() const noexcept
+                {
+                    return m_usePmr ? m_pmr.size() : m_std.size();
+                }
 
-            inline void AddOption(ResultValueView&& rv)
+                inline bool empty() const noexcept
+                {
+                    return size() == 0;
+                }
+
+                inline T const& operator[](size_t i) const noexcept
+                {
+                    return begin()[i];
+                }
+
+            private:
+                std::vector<T> m_std;
+                std::pmr::vector<T> m_pmr;
+                bool m_usePmr;
+            };
+
+            static inline std::pmr::memory_resource* ResourceOrDefault(std::pmr::memory_resource* memory) noexcept
             {
-                m_options.push_back(std::move(rv));
+                return (memory == nullptr) ? std::pmr::get_default_resource() : memory;
             }
 
-            inline void AddSwitch(Switch<CHAR> const& swt)
+            /// <summary>
+            /// One entry of the index, an open-addressing hash table keyed by identity.
+            /// For Options, `first` is the offset into `m_optionsBySource`, for Arguments the offset into
+            /// `m_matchedArguments`. An `id` of zero marks an unused slot, as identities start at 1.
+            /// </summary>
+            struct IndexSlot
             {
-                m_switches.push_back(swt);
-            }
+                uint32_t id;
+                uint32_t first;
+                uint32_t count;
+                uint32_t filled;
+            };
 
-            inline void AddMatchedArgument(ResultValueView&& rv)
+            static inline size_t IndexHash(uint32_t id) noexcept
             {
-                m_matchedArguments.push_back(std::move(rv));
+                return static_cast<size_t>(id * 2654435761u);
             }
 
-            inline void AddUnmatchedArgument(ResultValueView&& rv)
+            inline IndexSlot const* FindIndexSlot(WithIdentity<CHAR> const& obj) const noexcept
             {
-                m_unmatchedArguments.push_back(std::move(rv));
+                if (m_index.empty())
+                {
+                    return nullptr;
+                }
+                const uint32_t id = obj.GetId();
+                const size_t mask = m_index.size() - 1;
+                for (size_t i = IndexHash(id) & mask; m_index[i].id != 0; i = (i + 1) & mask)
+                {
+                    if (m_index[i].id == id)
+                    {
+                        return &m_index[i];
+                    }
+                }
+                return nullptr;
             }
 
-            inline std::shared_ptr<ResultErrorInfo> GetErrorInfo()
+            inline IndexSlot& GetIndexSlot(uint32_t id) noexcept
             {
-                return m_errorInfo;
+                const size_t mask = m_index.size() - 1;
+                size_t i = IndexHash(id) & mask;
+                while (m_index[i].id != 0 && m_index[i].id != id)
+                {
+                    i = (i + 1) & mask;
+                }
+                m_index[i].id = id;
+                return m_index[i];
             }
 
-        private:
-            std::shared_ptr<ResultErrorInfo> m_errorInfo{std::make_shared<ResultErrorInfo>()};
+            std::shared_ptr<ResultErrorInfo> m_errorInfo;
+
+            Entries<WithIdentity<CHAR>> m_commands;
+            Entries<ResultValueView> m_options;
+            Entries<WithIdentity<CHAR>> m_switches;
+            Entries<ResultValueView> m_matchedArguments;
+            Entries<ResultValueView> m_unmatchedArguments;
 
-            std::vector<WithIdentity<CHAR>> m_commands;
-            std::vector<ResultValueView> m_options;
-            std::vector<WithIdentity<CHAR>> m_switches;
-            std::vector<ResultValueView> m_matchedArguments;
-            std::vector<ResultValueView> m_unmatchedArguments;
+            std::pmr::vector<ResultValueView> m_optionsBySource;
+            std::pmr::vector<IndexSlot> m_index;
+            std::pmr::vector<std::shared_ptr<const void>> m_storage;
         };
 
         /// <summary>
         /// Parses the specified command line and returns the parse result
         /// </summary>
-        Result Parse(int argc, const CHAR* const* argv, bool skipFirstArg = true) const;
+        inline Result Parse(int argc, const CHAR* const* argv, bool skipFirstArg = true) const
+        {
+            return Parse(argc, argv, skipFirstArg, nullptr);
+        }
+
+        /// <summary>
+        /// Parses the specified command line and returns the parse result.
+        /// All memory of the result and of the parsing process is allocated from `memory`, which must outlive the
+        /// returned Result, e.g. a `std::pmr::monotonic_buffer_resource` released after each request.
+        /// The entries of the Result are then returned by the `Pmr...` accessors, e.g. `PmrOptions`. With `memory`
+        /// being nullptr, this is the same as the overload without memory resource.
+        /// </summary>
+        Result Parse(int argc, const CHAR* const* argv, bool skipFirstArg, std::pmr::memory_resource* memory) const;
+
+        /// <summary>
+        /// Splits the command line string into arguments, and parses them.
+        /// Arguments are separated by white space, and can be quoted with `"` or `'`. A backslash escapes a following
+        /// quote or white space character. The values of the Result point into `commandLine`, which must outlive the
+        /// Result, except for arguments with quotes or escapes, which are stored in one buffer of the Result.
+        /// </summary>
+        inline Result Parse(std::basic_string_view<CHAR> commandLine, bool skipFirstArg = false) const
+        {
+            return Parse(commandLine, skipFirstArg, nullptr);
+        }
+
+        Result Parse(std::basic_string_view<CHAR> commandLine, bool skipFirstArg,
+                     std::pmr::memory_resource* memory) const;
+
+        /// <summary>
+        /// One command line of a batch
+        /// </summary>
+        struct CommandLine
+        {
+            int argc;
+            const CHAR* const* argv;
+        };
+
+        /// <summary>
+        /// Parses a batch of command lines on `threadCount` worker threads, and returns the results in the order of
+        /// the input command lines. With `threadCount` zero, one thread per hardware thread is used.
+        /// The parser must not be changed while the batch is parsed.
+        /// </summary>
+        std::vector<Result> ParseBatch(const CommandLine* commandLines, size_t count, bool skipFirstArg = true,
+                                       unsigned int threadCount = 0) const;
+
+        inline std::vector<Result> ParseBatch(const std::vector<CommandLine>& commandLines, bool skipFirstArg = true,
+                                              unsigned int threadCount = 0) const
+        {
+            return ParseBatch(commandLines.data(), commandLines.size(), skipFirstArg, threadCount);
+        }
 
         /// <summary>
         /// Prints a user-readable help text
@@ -1183,6 +4285,28 @@ namespace yaclap
         template <typename TSTREAMT = typename std::basic_ostream<CHAR>::traits_type>
         inline void PrintErrorAndHelpIfNeeded(Result const& result, std::basic_ostream<CHAR, TSTREAMT>& stream) const;
 
+        enum class Shell
+        {
+            Bash,
+            Zsh,
+            Fish
+        };
+
+        /// <summary>
+        /// Prints a standalone completion script for `shell`, completing the Commands, Options, and Switches of the
+        /// grammar without running the application. Items hidden from the help are not offered, and values of
+        /// Options are completed as file names. Names are matched case-sensitively, and names containing white
+        /// space or quotes are left out. The program name is quoted for the shell if needed, in which case the zsh
+        /// script has no `#compdef` line, and registers itself only when sourced.
+        /// </summary>
+        template <typename TSTREAMT = typename std::basic_ostream<CHAR>::traits_type>
+        void PrintCompletionScript(Shell shell, std::basic_ostream<CHAR, TSTREAMT>& stream) const;
+
+        /// <summary>
+        /// Prints a standalone completion script for `shell` to `stdout`
+        /// </summary>
+        inline void PrintCompletionScript(Shell shell) const;
+
     private:
         struct StringConsts;
 
@@ -1196,17 +4320,75 @@ namespace yaclap
             return length;
         }
 
+        /// <summary>
+        /// Prints the help text from the help cache, rendering it on first use for the command and console width
+        /// </summary>
         template <typename TSTREAMT = typename std::basic_ostream<CHAR>::traits_type>
         void PrintHelpImpl(Command<CHAR> const* command, std::basic_ostream<CHAR, TSTREAMT>& stream) const;
 
+        template <typename TSTREAMT = typename std::basic_ostream<CHAR>::traits_type>
+        void RenderHelp(Command<CHAR> const* command, std::basic_ostream<CHAR, TSTREAMT>& stream, size_t width) const;
+
+        static size_t GetConsoleWidth();
+
+        /// <summary>
+        /// Rendered help texts, keyed by the identity of the command (0 for the parser itself) and the console width.
+        /// The cache is thread-safe, and is cleared when the grammar of the parser changes. Copies of a parser start
+        /// with an empty cache.
+        /// </summary>
+        class HelpCache
+        {
+        public:
+            HelpCache() = default;
+
+            HelpCache(const HelpCache&) noexcept
+            {
+            }
+
+            HelpCache& operator=(const HelpCache&)
+            {
+                Clear();
+                return *this;
+            }
+
+            void Clear()
+            {
+                std::lock_guard<std::mutex> lock{m_mutex};
+                m_entries.clear();
+            }
+
+            std::basic_string<CHAR> const* Find(uint64_t key) const
+            {
+                std::lock_guard<std::mutex> lock{m_mutex};
+                auto it = m_entries.find(key);
+                return (it == m_entries.end()) ? nullptr : &it->second;
+            }
+
+            /// <summary>
+            /// Stores the text, unless another thread stored one for the same key first, and returns the stored text.
+            /// The returned text stays valid until the cache is cleared.
+            /// </summary>
+            std::basic_string<CHAR> const& Insert(uint64_t key, std::basic_string<CHAR>&& text)
+            {
+                std::lock_guard<std::mutex> lock{m_mutex};
+                return m_entries.try_emplace(key, std::move(text)).first->second;
+            }
+
+        private:
+            mutable std::mutex m_mutex;
+            std::unordered_map<uint64_t, std::basic_string<CHAR>> m_entries;
+        };
+
         class ResultValueViewImpl : public ResultValueView
         {
         public:
             ResultValueViewImpl() = default;
 
-            ResultValueViewImpl(std::basic_string_view<CHAR> str, std::shared_ptr<ResultErrorInfo> errorInfo,
-                                std::optional<WithIdentity<CHAR>> source, int position)
-                : ResultValueView(str, errorInfo, source, position)
+            ResultValueViewImpl(std::basic_string_view<CHAR> str, ResultErrorInfo* errorInfo,
+                                std::optional<WithIdentity<CHAR>> source, int position,
+                                uint32_t cacheSlot = ResultValueView::noCacheSlot,
+                                ValueOrigin origin = ValueOrigin::CommandLine)
+                : ResultValueView(str, errorInfo, source, position, cacheSlot, origin)
             {
             }
         };
@@ -1214,21 +4396,272 @@ namespace yaclap
         class ResultImpl : public Result
         {
         public:
-            ResultImpl()
-                : Result()
+            explicit ResultImpl(std::pmr::memory_resource* memory)
+                : Result(memory)
             {
             }
 
             using Result::AddCommand;
             using Result::AddMatchedArgument;
             using Result::AddOption;
+            using Result::AddStorage;
             using Result::AddSwitch;
             using Result::AddUnmatchedArgument;
+            using Result::BuildIndex;
+            using Result::Clear;
             using Result::GetErrorInfo;
         };
 
+        /// <summary>
+        /// The state of the parsing process: the active scopes, the Arguments still to be matched, and the Option
+        /// still waiting for its value
+        /// </summary>
+        struct ParseState
+        {
+            /// <summary>
+            /// One argument of the command line, with its position in `argv`
+            /// </summary>
+            struct Token
+            {
+                std::basic_string_view<CHAR> text;
+                int position;
+            };
+
+            explicit ParseState(std::pmr::memory_resource* memory)
+                : tokens{memory}, scopes{memory}, arguments{memory}
+            {
+            }
+
+            void Reset(Parser<CHAR> const& parser);
+
+            void AddArguments(WithCommandContainer<CHAR> const& scope);
+
+            Option<CHAR> const* FindOption(typename NameIndex<CHAR>::Key const& key) const;
+
+            Switch<CHAR> const* FindSwitch(typename NameIndex<CHAR>::Key const& key) const;
+
+            std::pmr::vector<Token> tokens;
+
+            // Unescaped arguments of a command line string, shared with the Result referencing them
+            std::shared_ptr<std::pmr::basic_string<CHAR>> textBuffer;
+
+            // The parser itself followed by the chain of matched commands.
+            // The commands of the last scope, and the options and switches of all scopes can be matched.
+            std::pmr::vector<WithCommandContainer<CHAR> const*> scopes;
+            std::pmr::vector<Argument<CHAR> const*> arguments;
+            size_t nextArgument{0};
+            Option<CHAR> const* pendingOption{nullptr};
+            bool errorOnUnmatchedArguments{true};
+            bool stopped{false};
+        };
+
+        /// <summary>
+        /// What an argument of the command line was matched to
+        /// </summary>
+        struct TokenMatch
+        {
+            enum class Kind
+            {
+                StopToken,
+                Command,
+                OptionName,
+                OptionValue,
+                Switch,
+                HelpSwitch,
+                Argument,
+                Unmatched,
+                Error
+            };
+
+            Kind kind;
+            Command<CHAR> const* command;
+            Option<CHAR> const* option;
+            Switch<CHAR> const* switchOption;
+            Argument<CHAR> const* argument;
+            std::basic_string_view<CHAR> value;
+        };
+
+        /// <summary>
+        /// Matches one argument in the current state against the grammar, and advances the state accordingly
+        /// </summary>
+        TokenMatch MatchToken(ParseState& state, std::basic_string_view<CHAR> arg) const;
+
+        void ParseImpl(ResultImpl& res, ParseState& state, int argc, const CHAR* const* argv, bool skipFirstArg) const;
+
+        void ParseImpl(ResultImpl& res, ParseState& state, std::basic_string_view<CHAR> commandLine,
+                       bool skipFirstArg) const;
+
+        /// <summary>
+        /// Appends the argument to `state.tokens`, or the arguments of the response file it references
+        /// </summary>
+        bool AddToken(ResultImpl& res, ParseState& state, std::basic_string_view<CHAR> arg, int position,
+                      bool& stopped, std::vector<std::filesystem::path>& openFiles) const;
+
+        /// <summary>
+        /// Matches `state.tokens` against the grammar
+        /// </summary>
+        void ParseTokens(ResultImpl& res, ParseState& state) const;
+
+        /// <summary>
+        /// Adds the values of the Options and Switches of the active scopes which are missing from the command line,
+        /// taken from the environment, or else from the config files. `slot` is the next free cache slot. Returns true
+        /// if values were added, and sets `conversionFailed` if a value could not be converted.
+        /// </summary>
+        bool AddFallbackValues(ResultImpl& res, ParseState const& state, uint32_t slot, bool& conversionFailed) const;
+
+        /// <summary>
+        /// Calls `func` for all entries for `obj`, an Option or Switch, of the config file with the highest
+        /// precedence having any, in the section of the Command path `pathBegin` to `pathEnd`, or the root section
+        /// if the path is empty. Returns true if `func` was called.
+        /// </summary>
+        template <typename T, typename F>
+        bool ForEachConfigEntry(T const& obj, WithCommandContainer<CHAR> const* const* pathBegin,
+                                WithCommandContainer<CHAR> const* const* pathEnd, F&& func) const;
+
+        /// <summary>
+        /// Appends the arguments of the response file `path` to `state.tokens`, expanding nested response files.
+        /// `openFiles` holds the canonical paths of the response files currently being expanded, to detect cycles.
+        /// Returns false and sets the error of `res` if a file cannot be read or expanded.
+        /// </summary>
+        bool ExpandResponseFile(ResultImpl& res, ParseState& state, std::basic_string_view<CHAR> path, int position,
+                                bool& stopped, std::vector<std::filesystem::path>& openFiles) const;
+
+        Switch<CHAR> m_helpSwitch;
+        mutable HelpCache m_helpCache;
         bool m_withImplicitHelpSwitch = true;
         bool m_errorOnUnmatchedArguments = true;
+        bool m_withResponseFiles = false;
+        std::shared_ptr<const Environment<CHAR>> m_environment;
+        std::vector<std::shared_ptr<const ConfigFile<CHAR>>> m_configFiles;
+
+    public:
+        /// <summary>
+        /// Repeatedly parses command lines with one Parser.
+        /// The session keeps its Result and all working memory between calls to `Parse`, and clears and refills
+        /// them instead of allocating new ones. After the first few calls, parsing does not allocate memory, unless
+        /// an error message is set or a command line exceeds the sizes seen before.
+        /// The parser must outlive the session, and must not be changed while the session parses.
+        /// </summary>
+        class Session
+        {
+        public:
+            /// <summary>
+            /// Creates a session. With `memory` being nullptr, the Result stores its entries in std::vectors,
+            /// otherwise all memory is allocated from `memory`, see `Parser::Parse`.
+            /// </summary>
+            explicit Session(Parser<CHAR> const& parser, std::pmr::memory_resource* memory = nullptr)
+                : m_parser{parser}, m_result{memory},
+                  m_state{(memory == nullptr) ? std::pmr::get_default_resource() : memory}
+            {
+            }
+
+            /// <summary>
+            /// Parses the specified command line. The returned Result is valid until the next call to `Parse`.
+            /// </summary>
+            Result& Parse(int argc, const CHAR* const* argv, bool skipFirstArg = true);
+
+            /// <summary>
+            /// Splits the command line string into arguments, and parses them.
+            /// The returned Result is valid until the next call to `Parse`.
+            /// </summary>
+            Result& Parse(std::basic_string_view<CHAR> commandLine, bool skipFirstArg = false);
+
+            /// <summary>
+            /// Returns the Result of the last call to `Parse`
+            /// </summary>
+            inline Result& GetResult() noexcept
+            {
+                return m_result;
+            }
+
+        private:
+            Parser<CHAR> const& m_parser;
+            ResultImpl m_result;
+            ParseState m_state;
+        };
+
+        /// <summary>
+        /// Computes shell completion candidates for a partial command line.
+        /// The completion keeps the parse state of the arguments in front of the cursor. When called again with a
+        /// command line sharing a prefix with the previous one, e.g. for the next key stroke, only the changed
+        /// arguments are parsed again. Response files are not expanded.
+        /// The parser must outlive the completion, and must not be changed while it is used.
+        /// </summary>
+        class Completion
+        {
+        public:
+            explicit Completion(Parser<CHAR> const& parser,
+                                std::pmr::memory_resource* memory = std::pmr::get_default_resource())
+                : m_parser{parser}, m_state{memory}, m_consumed{memory}, m_steps{memory}, m_candidates{memory}
+            {
+                m_state.Reset(m_parser);
+            }
+
+            /// <summary>
+            /// Returns the names of Commands, Options, and Switches which complete the argument `argv[cursor]`.
+            /// The arguments in front of the cursor are parsed as complete arguments. If `cursor` equals `argc`, a
+            /// new empty argument is completed. The returned names point into the grammar, and are valid until the
+            /// next call to `Complete`. No names are returned, if the argument is the value of an Option, see
+            /// `GetPendingOption`, or if it follows the parser stop token `--`.
+            /// </summary>
+            std::pmr::vector<std::basic_string_view<CHAR>> const& Complete(int argc, const CHAR* const* argv,
+                                                                          int cursor, bool skipFirstArg = true);
+
+            /// <summary>
+            /// Returns the Option the completed argument is the value of, or nullptr
+            /// </summary>
+            inline Option<CHAR> const* GetPendingOption() const noexcept
+            {
+                return m_state.pendingOption;
+            }
+
+            /// <summary>
+            /// Returns the Argument the completed argument would be matched to, if it is no name, or nullptr
+            /// </summary>
+            inline Argument<CHAR> const* GetPendingArgument() const noexcept
+            {
+                if (m_state.stopped || m_state.pendingOption != nullptr ||
+                    m_state.nextArgument >= m_state.arguments.size())
+                {
+                    return nullptr;
+                }
+                return m_state.arguments[m_state.nextArgument];
+            }
+
+            /// <summary>
+            /// Returns the innermost matched Command, or nullptr if no Command was matched
+            /// </summary>
+            inline Command<CHAR> const* GetCommand() const noexcept
+            {
+                return m_state.scopes.size() > 1 ? static_cast<Command<CHAR> const*>(m_state.scopes.back()) : nullptr;
+            }
+
+        private:
+            /// <summary>
+            /// The parse state in front of one consumed argument. The scopes and arguments of the ParseState only
+            /// grow, so truncating them restores the state.
+            /// </summary>
+            struct Step
+            {
+                size_t scopeCount;
+                size_t argumentCount;
+                size_t nextArgument;
+                Option<CHAR> const* pendingOption;
+                bool errorOnUnmatchedArguments;
+                bool stopped;
+            };
+
+            void Rewind(size_t count);
+
+            template <typename ITEM>
+            void AddCandidates(ITEM const& item, std::basic_string_view<CHAR> prefix);
+
+            Parser<CHAR> const& m_parser;
+            ParseState m_state;
+            std::pmr::vector<std::pmr::basic_string<CHAR>> m_consumed;
+            std::pmr::vector<Step> m_steps;
+            std::pmr::vector<std::basic_string_view<CHAR>> m_candidates;
+        };
     };
 
     template <>
@@ -1286,6 +4719,59 @@ namespace yaclap
         stream << "\n";
     }
 
+    template <typename CHAR>
+    void Parser<CHAR>::Result::BuildIndex()
+    {
+        const size_t entries = m_commands.size() + m_options.size() + m_switches.size() + m_matchedArguments.size();
+        size_t size = 8;
+        while (size < entries * 2)
+        {
+            size *= 2;
+        }
+        m_index.assign(size, IndexSlot{0, 0, 0, 0});
+
+        for (WithIdentity<CHAR> const& cmd : m_commands)
+        {
+            GetIndexSlot(cmd.GetId()).count++;
+        }
+        for (WithIdentity<CHAR> const& swt : m_switches)
+        {
+            GetIndexSlot(swt.GetId()).count++;
+        }
+        for (size_t i = 0; i < m_matchedArguments.size(); ++i)
+        {
+            IndexSlot& slot = GetIndexSlot(m_matchedArguments[i].GetSource()->GetId());
+            if (slot.count++ == 0)
+            {
+                slot.first = static_cast<uint32_t>(i);
+            }
+        }
+
+        // Counting sort of the option values by their source, keeping the command line order per source
+        for (ResultValueView const& opt : m_options)
+        {
+            GetIndexSlot(opt.GetSource()->GetId()).count++;
+        }
+        uint32_t offset = 0;
+        for (ResultValueView const& opt : m_options)
+        {
+            IndexSlot& slot = GetIndexSlot(opt.GetSource()->GetId());
+            if (slot.filled == 0)
+            {
+                slot.first = offset;
+                offset += slot.count;
+                slot.filled = 1;
+            }
+        }
+        m_optionsBySource.resize(m_options.size());
+        for (ResultValueView const& opt : m_options)
+        {
+            IndexSlot& slot = GetIndexSlot(opt.GetSource()->GetId());
+            m_optionsBySource[slot.first + slot.filled - 1] = opt;
+            slot.filled++;
+        }
+    }
+
     template <typename CHAR>
     template <typename TSTREAMT>
     void Parser<CHAR>::PrintHelp(Command<CHAR> const& command, std::basic_ostream<CHAR, TSTREAMT>& stream) const
@@ -1298,9 +4784,10 @@ namespace yaclap
     void Parser<CHAR>::PrintHelp(Result const& result, std::basic_ostream<CHAR, TSTREAMT>& stream) const
     {
         Command<CHAR> const* cmd = nullptr;
-        if (!result.Commands().empty())
+        if (!result.Commands().empty() || !result.PmrCommands().empty())
         {
-            WithIdentity<CHAR> cmdId = result.Commands().back();
+            WithIdentity<CHAR> cmdId =
+                result.Commands().empty() ? result.PmrCommands().back() : result.Commands().back();
             for (auto cmdIt = WithCommandContainer<CHAR>::CommandsBegin();
                  cmdIt != WithCommandContainer<CHAR>::CommandsEnd(); ++cmdIt)
             {
@@ -1321,6 +4808,338 @@ namespace yaclap
         PrintHelpImpl(nullptr, stream);
     }
 
+    template <typename CHAR>
+    template <typename TSTREAMT>
+    void Parser<CHAR>::PrintCompletionScript(Shell shell, std::basic_ostream<CHAR, TSTREAMT>& stream) const
+    {
+        using string_view_t = std::basic_string_view<CHAR>;
+
+        // Each state is one chain of Commands; state 0 is the parser itself
+        struct State
+        {
+            std::vector<WithCommandContainer<CHAR> const*> scopes;
+            std::vector<std::pair<string_view_t, size_t>> transitions;
+            std::vector<string_view_t> words;
+            std::vector<string_view_t> valueOptions;
+        };
+
+        auto isSafe = [](string_view_t name)
+        {
+            return !name.empty() && std::none_of(name.begin(), name.end(), [](CHAR c)
+                                                 { return c == '\'' || c == '"' || Tokenizer<CHAR>::IsSpace(c); });
+        };
+        auto addNames = [&](std::vector<string_view_t>& list, WithNameAndAlias<CHAR> const& item)
+        {
+            for (auto aliasIt = item.NameAliasBegin(); aliasIt != item.NameAliasEnd(); ++aliasIt)
+            {
+                if (isSafe(aliasIt->GetNameView()))
+                {
+                    list.push_back(aliasIt->GetNameView());
+                }
+            }
+        };
+
+        std::vector<State> states(1);
+        states[0].scopes.push_back(this);
+        for (size_t i = 0; i < states.size(); ++i)
+        {
+            WithCommandContainer<CHAR> const* scope = states[i].scopes.back();
+            for (auto cmdIt = scope->CommandsBegin(); cmdIt != scope->CommandsEnd(); ++cmdIt)
+            {
+                State child;
+                child.scopes = states[i].scopes;
+                child.scopes.push_back(&*cmdIt);
+                for (auto aliasIt = cmdIt->NameAliasBegin(); aliasIt != cmdIt->NameAliasEnd(); ++aliasIt)
+                {
+                    if (isSafe(aliasIt->GetNameView()))
+                    {
+                        states[i].transitions.emplace_back(aliasIt->GetNameView(), states.size());
+                    }
+                }
+                if (!cmdIt->DoesHideFromHelp())
+                {
+                    addNames(states[i].words, *cmdIt);
+                }
+                states.push_back(std::move(child));
+            }
+            for (WithCommandContainer<CHAR> const* sc : states[i].scopes)
+            {
+                for (auto optIt = sc->OptionsBegin(); optIt != sc->OptionsEnd(); ++optIt)
+                {
+                    addNames(states[i].valueOptions, *optIt);
+                    if (!optIt->DoesHideFromHelp())
+                    {
+                        addNames(states[i].words, *optIt);
+                    }
+                }
+                for (auto swtIt = sc->SwitchesBegin(); swtIt != sc->SwitchesEnd(); ++swtIt)
+                {
+                    if (!swtIt->DoesHideFromHelp())
+                    {
+                        addNames(states[i].words, *swtIt);
+                    }
+                }
+            }
+            if (m_withImplicitHelpSwitch)
+            {
+                addNames(states[i].words, m_helpSwitch);
+            }
+        }
+
+        auto out = [&](const char* text)
+        {
+            for (; *text != 0; ++text)
+            {
+                stream.put(stream.widen(*text));
+            }
+        };
+        // Words are expanded by the shell before matching, so escape its special characters
+        auto outWord = [&](string_view_t word)
+        {
+            for (CHAR c : word)
+            {
+                if (c < 0x80 && std::strchr("\\$`*?[]{}()<>|&;!~#", static_cast<char>(c)) != nullptr)
+                {
+                    stream.put(stream.widen('\\'));
+                }
+                stream.put(c);
+            }
+        };
+        auto outWords = [&](std::vector<string_view_t> const& words)
+        {
+            for (size_t w = 0; w < words.size(); ++w)
+            {
+                out(w == 0 ? "'" : " ");
+                outWord(words[w]);
+            }
+            out("'");
+        };
+        auto outPattern = [&](size_t state, string_view_t name)
+        {
+            out("'");
+            stream << state;
+            out(":");
+            stream << name;
+            out("'");
+        };
+
+        const string_view_t name = WithName<CHAR>::GetNameView();
+        std::basic_string<CHAR> id;
+        for (CHAR c : name)
+        {
+            const bool alnum = (c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+            id += alnum ? c : static_cast<CHAR>('_');
+        }
+
+        // The program name is one shell word, quoted if it contains white space or special characters
+        auto isPlain = [](CHAR c)
+        {
+            const bool alnum = (c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+            return alnum || (c > 0x20 && c < 0x80 && std::strchr("._+-/:@%,=", static_cast<char>(c)) != nullptr);
+        };
+        const bool quoteName = name.empty() || !std::all_of(name.begin(), name.end(), isPlain);
+        auto outName = [&](bool fish)
+        {
+            if (!quoteName)
+            {
+                stream << name;
+                return;
+            }
+            out("'");
+            for (CHAR c : name)
+            {
+                if (c == '\'')
+                {
+                    // fish escapes quotes within single quotes, sh ends the quote for an escaped quote
+                    out(fish ? "\\'" : "'\\''");
+                }
+                else if (fish && c == '\\')
+                {
+                    out("\\\\");
+                }
+                else
+                {
+                    stream.put(c);
+                }
+            }
+            out("'");
+        };
+        // Comments end at line breaks
+        auto outNameComment = [&]()
+        {
+            for (CHAR c : name)
+            {
+                stream.put((c == '\n' || c == '\r') ? stream.widen(' ') : c);
+            }
+        };
+
+        if (shell == Shell::Bash || shell == Shell::Zsh)
+        {
+            const bool bash = shell == Shell::Bash;
+            if (!bash && !quoteName)
+            {
+                // compinit splits this line at white space without removing quotes
+                out("#compdef ");
+                stream << name;
+                out("\n");
+            }
+            out(bash ? "# bash" : "# zsh");
+            out(" completion for ");
+            outNameComment();
+            out(", generated by yaclap\n_yaclap_");
+            stream << id;
+            out("()\n{\n    local state=0 i\n");
+            out(bash ? "    for ((i = 1; i < COMP_CWORD; i++)); do\n        case \"$state:${COMP_WORDS[i]}\" in\n"
+                     : "    for ((i = 2; i < CURRENT; i++)); do\n        case \"$state:${words[i]}\" in\n");
+            out("            *:--) state=-1; break ;;\n");
+            for (size_t i = 0; i < states.size(); ++i)
+            {
+                for (auto const& t : states[i].transitions)
+                {
+                    out("            ");
+                    outPattern(i, t.first);
+                    out(") state=");
+                    stream << t.second;
+                    out(" ;;\n");
+                }
+                if (!states[i].valueOptions.empty())
+                {
+                    out("            ");
+                    for (size_t o = 0; o < states[i].valueOptions.size(); ++o)
+                    {
+                        if (o > 0)
+                        {
+                            out("|");
+                        }
+                        outPattern(i, states[i].valueOptions[o]);
+                    }
+                    out(") ((i++)) ;;\n");
+                }
+            }
+            out("        esac\n    done\n");
+            // After the stop token, and for option values, fall back to file names
+            out(bash ? "    if [[ $state == -1 || $i -gt $COMP_CWORD ]]; then\n        COMPREPLY=()\n        return 0\n"
+                     : "    if [[ $state == -1 || $i -gt $CURRENT ]]; then\n        _files\n        return\n");
+            out("    fi\n");
+            if (bash)
+            {
+                out("    local words=''\n");
+            }
+            out("    case $state in\n");
+            for (size_t i = 0; i < states.size(); ++i)
+            {
+                if (states[i].words.empty())
+                {
+                    continue;
+                }
+                out("        ");
+                stream << i;
+                out(bash ? ") words=" : ") compadd -- ");
+                if (bash)
+                {
+                    outWords(states[i].words);
+                }
+                else
+                {
+                    for (size_t w = 0; w < states[i].words.size(); ++w)
+                    {
+                        out(w == 0 ? "'" : " '");
+                        stream << states[i].words[w];
+                        out("'");
+                    }
+                    out(" && return");
+                }
+                out(" ;;\n");
+            }
+            out("    esac\n");
+            out(bash ? "    COMPREPLY=($(compgen -W \"$words\" -- \"${COMP_WORDS[COMP_CWORD]}\"))\n}\n"
+                       "complete -o default -F "
+                     : "    _files\n}\ncompdef ");
+            out("_yaclap_");
+            stream << id << stream.widen(' ');
+            outName(false);
+            out("\n");
+        }
+        else
+        {
+            out("# fish completion for ");
+            outNameComment();
+            out(", generated by yaclap\nfunction __yaclap_");
+            stream << id;
+            out("_state\n    set -l tokens (commandline -opc)\n    set -l state 0\n    set -l skip 0\n");
+            out("    for w in $tokens[2..-1]\n");
+            out("        if test $skip = 1\n            set skip 0\n            continue\n        end\n");
+            out("        if test \"$w\" = \"--\"\n            echo stop\n            return\n        end\n");
+            out("        switch $state\n");
+            for (size_t i = 0; i < states.size(); ++i)
+            {
+                if (states[i].transitions.empty() && states[i].valueOptions.empty())
+                {
+                    continue;
+                }
+                out("            case ");
+                stream << i;
+                out("\n");
+                const char* keyword = "                if contains -- $w";
+                for (size_t t = 0; t < states[i].transitions.size();)
+                {
+                    const size_t target = states[i].transitions[t].second;
+                    out(keyword);
+                    for (; t < states[i].transitions.size() && states[i].transitions[t].second == target; ++t)
+                    {
+                        out(" '");
+                        stream << states[i].transitions[t].first;
+                        out("'");
+                    }
+                    out("\n                    set state ");
+                    stream << target;
+                    out("\n");
+                    keyword = "                else if contains -- $w";
+                }
+                if (!states[i].valueOptions.empty())
+                {
+                    out(keyword);
+                    for (string_view_t opt : states[i].valueOptions)
+                    {
+                        out(" '");
+                        stream << opt;
+                        out("'");
+                    }
+                    out("\n                    set skip 1\n");
+                }
+                out("                end\n");
+            }
+            out("        end\n    end\n    if test $skip = 1\n        echo value\n        return\n    end\n"
+                "    echo $state\nend\n");
+
+            out("complete -c ");
+            outName(true);
+            out(" -f\n");
+            for (size_t i = 0; i < states.size(); ++i)
+            {
+                if (states[i].words.empty())
+                {
+                    continue;
+                }
+                out("complete -c ");
+                outName(true);
+                out(" -n 'test (__yaclap_");
+                stream << id;
+                out("_state) = ");
+                stream << i;
+                out("' -a ");
+                outWords(states[i].words);
+                out("\n");
+            }
+            // After the stop token, and for option values, fall back to file names
+            out("complete -c ");
+            outName(true);
+            out(" -n 'contains (__yaclap_");
+            stream << id;
+            out("_state) value stop' -F\n");
+        }
+    }
+
     template <>
     inline void Parser<char>::PrintHelp(Command<char> const& command) const
     {
@@ -1357,6 +5176,18 @@ namespace yaclap
         PrintHelpImpl(nullptr, std::wcout);
     }
 
+    template <>
+    inline void Parser<char>::PrintCompletionScript(Shell shell) const
+    {
+        PrintCompletionScript(shell, std::cout);
+    }
+
+    template <>
+    inline void Parser<wchar_t>::PrintCompletionScript(Shell shell) const
+    {
+        PrintCompletionScript(shell, std::wcout);
+    }
+
     template <>
     struct Parser<char>::StringConsts
     {
@@ -1384,6 +5215,7 @@ namespace yaclap
         static constexpr char const* helpDescription = "Show help and usage information";
 
         static constexpr char const* parserStopToken = "--";
+        static constexpr char const* optionValueSeparators = ": =";
 
         static constexpr char const* errorOptionNoValue = "Value of option expected, but no more arguments: ";
         static constexpr char const* errorUnmatchedArguments = "Unmatched arguments present in command line";
@@ -1392,12 +5224,22 @@ namespace yaclap
             "Option was specified multiple times in the command line: ";
 
         static constexpr char const* errorParserValueConversion = "Failed to convert value for argument ";
+        static constexpr char const* errorEnvironmentValueConversion =
+            "Failed to convert value of environment variable ";
+        static constexpr char const* errorConfigFileValueConversion = "Failed to convert value in config file line ";
         static constexpr char const* errorGenericParserError = "internal generic error";
+        static constexpr char const* errorResponseFileRead = "Failed to read response file: ";
+        static constexpr char const* errorResponseFileRecursion = "Response file includes itself: ";
+        static constexpr char const* errorUnterminatedQuote = "Unterminated quote";
         static constexpr char const* errorParserUnexpectedCharAt = "unexpected character at position ";
         static constexpr char const* errorContextSeparator = ": ";
         static constexpr char const* errorMissingInput = "missing expected input";
         static constexpr char const* errorUnexpectedInput = "unexpected input";
         static constexpr char const* errorDataTypeLimit = "value exceeds supported data type limit";
+        static constexpr char const* errorListElement = "list element ";
+        static constexpr char const* errorListCapacity = "more list elements than supported";
+        static constexpr char const* errorRangeBounds = "value exceeds upper bound ";
+        static constexpr char const* errorRangeOrder = "range ends before it starts";
 
         static inline bool isspace(char c)
         {
@@ -1443,6 +5285,7 @@ namespace yaclap
         static constexpr wchar_t const* helpDescription = L"Show help and usage information";
 
         static constexpr wchar_t const* parserStopToken = L"--";
+        static constexpr wchar_t const* optionValueSeparators = L": =";
 
         static constexpr wchar_t const* errorOptionNoValue = L"Value of option expected, but no more arguments: ";
         static constexpr wchar_t const* errorUnmatchedArguments = L"Unmatched arguments present in command line";
@@ -1451,12 +5294,23 @@ namespace yaclap
             L"Option was specified multiple times in the command line: ";
 
         static constexpr wchar_t const* errorParserValueConversion = L"Failed to convert value for argument ";
+        static constexpr wchar_t const* errorEnvironmentValueConversion =
+            L"Failed to convert value of environment variable ";
+        static constexpr wchar_t const* errorConfigFileValueConversion =
+            L"Failed to convert value in config file line ";
         static constexpr wchar_t const* errorGenericParserError = L"internal generic error";
+        static constexpr wchar_t const* errorResponseFileRead = L"Failed to read response file: ";
+        static constexpr wchar_t const* errorResponseFileRecursion = L"Response file includes itself: ";
+        static constexpr wchar_t const* errorUnterminatedQuote = L"Unterminated quote";
         static constexpr wchar_t const* errorParserUnexpectedCharAt = L"unexpected character at position ";
         static constexpr wchar_t const* errorContextSeparator = L": ";
         static constexpr wchar_t const* errorMissingInput = L"missing expected input";
         static constexpr wchar_t const* errorUnexpectedInput = L"unexpected input";
         static constexpr wchar_t const* errorDataTypeLimit = L"value exceeds supported data type limit";
+        static constexpr wchar_t const* errorListElement = L"list element ";
+        static constexpr wchar_t const* errorListCapacity = L"more list elements than supported";
+        static constexpr wchar_t const* errorRangeBounds = L"value exceeds upper bound ";
+        static constexpr wchar_t const* errorRangeOrder = L"range ends before it starts";
 
         static inline bool isspace(wchar_t c)
         {
@@ -1479,14 +5333,14 @@ namespace yaclap
     std::basic_string<CHAR> WithNameAndAlias<CHAR>::GetAllNames() const
     {
         std::basic_string<CHAR> names;
-        for (Alias<CHAR> const& a : m_names)
+        for (const Alias<CHAR>* a = NameAliasBegin(); a != NameAliasEnd(); ++a)
         {
             if (!names.empty())
             {
                 names += static_cast<CHAR>(',');
                 names += static_cast<CHAR>(' ');
             }
-            names += a.GetName();
+            names += a->GetNameView();
         }
         return names;
     }
@@ -1495,10 +5349,22 @@ namespace yaclap
     template <typename TSTREAMT>
     void Parser<CHAR>::PrintHelpImpl(Command<CHAR> const* command, std::basic_ostream<CHAR, TSTREAMT>& stream) const
     {
-        using s = StringConsts;
-        using string = std::basic_string<CHAR>;
-        using stringPair = std::tuple<string, string>;
+        const size_t width = GetConsoleWidth();
+        const uint64_t key = (static_cast<uint64_t>(command == nullptr ? 0 : command->GetId()) << 32) | width;
+
+        std::basic_string<CHAR> const* text = m_helpCache.Find(key);
+        if (text == nullptr)
+        {
+            std::basic_ostringstream<CHAR> buffer;
+            RenderHelp(command, buffer, width);
+            text = &m_helpCache.Insert(key, std::move(buffer).str());
+        }
+        stream.write(text->data(), static_cast<std::streamsize>(text->size()));
+    }
 
+    template <typename CHAR>
+    size_t Parser<CHAR>::GetConsoleWidth()
+    {
         size_t width = 80;
 #ifdef _WIN32
         CONSOLE_SCREEN_BUFFER_INFO csbi;
@@ -1517,15 +5383,27 @@ namespace yaclap
         {
             width = 30;
         }
+        return width;
+    }
+
+    template <typename CHAR>
+    template <typename TSTREAMT>
+    void Parser<CHAR>::RenderHelp(Command<CHAR> const* command, std::basic_ostream<CHAR, TSTREAMT>& stream,
+                                  size_t width) const
+    {
+        using s = StringConsts;
+        using string = std::basic_string<CHAR>;
+        using stringPair = std::tuple<string, string>;
+
         width--; // reserve last column to host an explicit new line
 
         WithDescription<CHAR> const* desc = (command == nullptr) ? static_cast<WithDescription<CHAR> const*>(this)
                                                                  : static_cast<WithDescription<CHAR> const*>(command);
-        if (!desc->GetDescription().empty())
+        if (!desc->GetDescriptionView().empty())
         {
             stream << s::descriptionCaption << s::nl;
-            typename string::const_iterator descBegin = desc->GetDescription().cbegin();
-            typename string::const_iterator descEnd = desc->GetDescription().cend();
+            typename std::basic_string_view<CHAR>::const_iterator descBegin = desc->GetDescriptionView().cbegin();
+            typename std::basic_string_view<CHAR>::const_iterator descEnd = desc->GetDescriptionView().cend();
             while (descBegin != descEnd)
             {
                 size_t descLen = descEnd - descBegin;
@@ -1592,11 +5470,9 @@ namespace yaclap
             addRange(allArguments, c->ArgumentsBegin(), c->ArgumentsEnd());
         }
 
-        Switch<CHAR> helpSwitch{s::helpName, s::helpDescription};
-        helpSwitch.AddAlias(s::helpAlias1).AddAlias(s::helpAlias2).AddAlias(s::helpAlias3).AddAlias(s::helpAlias4);
         if (m_withImplicitHelpSwitch)
         {
-            allSwitches.push_back(&helpSwitch);
+            allSwitches.push_back(&m_helpSwitch);
         }
 
         allOptions.erase(std::remove_if(allOptions.begin(), allOptions.end(),
@@ -1608,8 +5484,8 @@ namespace yaclap
 
         size_t x = 0;
 
-        stream << s::usageCaption << s::nl << s::s << s::s << Parser<CHAR>::GetName();
-        x = 2 + Parser<CHAR>::GetName().size();
+        stream << s::usageCaption << s::nl << s::s << s::s << Parser<CHAR>::GetNameView();
+        x = 2 + Parser<CHAR>::GetNameView().size();
         auto optionalLineBreak = [&x, &width, &stream](size_t l)
         {
             if (x + l >= width)
@@ -1624,7 +5500,7 @@ namespace yaclap
         };
         for (auto c = commandChain.crbegin(); c != commandChain.crend(); ++c)
         {
-            auto const& n = (*c)->NameAliasBegin()->GetName();
+            auto const& n = (*c)->NameAliasBegin()->GetNameView();
             optionalLineBreak(n.size() + 1);
             stream << s::s << n;
         }
@@ -1653,7 +5529,7 @@ namespace yaclap
             {
                 continue;
             }
-            auto const& n = arg->GetName();
+            auto const& n = arg->GetNameView();
             optionalLineBreak(n.size() + 3);
             stream << s::s << s::ob << n << s::cb;
         }
@@ -1818,253 +5694,846 @@ namespace yaclap
                         }
                         descBegin = descNext;
                     }
-                    stream << s::nl;
+                    stream << s::nl;
+                }
+            }
+        };
+
+        if (!allArguments.empty())
+        {
+            stream << s::argumentsCaption << s::nl;
+            docu.clear();
+            for (Argument<CHAR> const* arg : allArguments)
+            {
+                string desc = (arg->IsRequired() ? s::tagRequired : s::tagOptional);
+                desc += s::s;
+                desc += arg->GetDescriptionView();
+                docu.push_back({string{arg->GetNameView()}, desc});
+            }
+
+            formatDocuTable();
+
+            stream << s::nl;
+        }
+
+        if (!allOptions.empty() || !allSwitches.empty())
+        {
+            stream << s::optionsCaption << s::nl;
+            docu.clear();
+            for (Option<CHAR> const* opt : allOptions)
+            {
+                string names = opt->GetAllNames() + s::nl + s::s + s::s + s::ob;
+                names += opt->GetArgumentNameView();
+                names += s::cb;
+                docu.push_back({names, string{opt->GetDescriptionView()}});
+            }
+            for (Switch<CHAR> const* sw : allSwitches)
+            {
+                docu.push_back({sw->GetAllNames(), string{sw->GetDescriptionView()}});
+            }
+
+            formatDocuTable();
+
+            stream << s::nl;
+        }
+
+        if (cmdsCnt > 0)
+        {
+            stream << s::commandsCaption << s::nl;
+            docu.clear();
+            for (auto cmdIt = cmds->CommandsBegin(); cmdIt != cmds->CommandsEnd(); ++cmdIt)
+            {
+                if (cmdIt->DoesHideFromHelp())
+                {
+                    continue;
+                }
+                docu.push_back({cmdIt->GetAllNames(), string{cmdIt->GetDescriptionView()}});
+            }
+
+            formatDocuTable();
+
+            stream << s::nl;
+        }
+    }
+
+    template <typename CHAR>
+    typename Parser<CHAR>::Result Parser<CHAR>::Parse(int argc, const CHAR* const* argv, bool skipFirstArg,
+                                                      std::pmr::memory_resource* memory) const
+    {
+        ResultImpl res{memory};
+        ParseState state{(memory == nullptr) ? std::pmr::get_default_resource() : memory};
+        ParseImpl(res, state, argc, argv, skipFirstArg);
+        return res;
+    }
+
+    template <typename CHAR>
+    typename Parser<CHAR>::Result Parser<CHAR>::Parse(std::basic_string_view<CHAR> commandLine, bool skipFirstArg,
+                                                      std::pmr::memory_resource* memory) const
+    {
+        ResultImpl res{memory};
+        ParseState state{(memory == nullptr) ? std::pmr::get_default_resource() : memory};
+        ParseImpl(res, state, commandLine, skipFirstArg);
+        return res;
+    }
+
+    template <typename CHAR>
+    std::vector<typename Parser<CHAR>::Result> Parser<CHAR>::ParseBatch(const CommandLine* commandLines, size_t count,
+                                                                        bool skipFirstArg,
+                                                                        unsigned int threadCount) const
+    {
+        // Workers claim small chunks of command lines from a shared cursor, so that threads finishing early take over
+        // the remaining work of the others
+        constexpr size_t chunkSize = 64;
+
+        std::vector<std::optional<ResultImpl>> slots(count);
+
+        if (threadCount == 0)
+        {
+            threadCount = (std::max)(1u, std::thread::hardware_concurrency());
+        }
+        threadCount = static_cast<unsigned int>(
+            (std::min<size_t>)(threadCount, (count + chunkSize - 1) / chunkSize));
+
+        std::atomic<size_t> cursor{0};
+        std::exception_ptr error;
+        std::atomic<bool> failed{false};
+
+        auto worker = [&]()
+        {
+            try
+            {
+                ParseState state{std::pmr::get_default_resource()};
+                while (!failed.load(std::memory_order_relaxed))
+                {
+                    const size_t begin = cursor.fetch_add(chunkSize, std::memory_order_relaxed);
+                    if (begin >= count)
+                    {
+                        break;
+                    }
+                    const size_t end = (std::min)(begin + chunkSize, count);
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        ParseImpl(slots[i].emplace(nullptr), state, commandLines[i].argc, commandLines[i].argv,
+                                  skipFirstArg);
+                    }
+                }
+            }
+            catch (...)
+            {
+                if (!failed.exchange(true))
+                {
+                    error = std::current_exception();
                 }
             }
         };
 
-        if (!allArguments.empty())
+        if (threadCount <= 1)
         {
-            stream << s::argumentsCaption << s::nl;
-            docu.clear();
-            for (Argument<CHAR> const* arg : allArguments)
+            worker();
+        }
+        else
+        {
+            std::vector<std::thread> threads;
+            threads.reserve(threadCount - 1);
+            try
             {
-                string desc = (arg->IsRequired() ? s::tagRequired : s::tagOptional);
-                desc += s::s;
-                desc += arg->GetDescription();
-                docu.push_back({arg->GetName(), desc});
+                for (unsigned int i = 1; i < threadCount; ++i)
+                {
+                    threads.emplace_back(worker);
+                }
+            }
+            catch (...)
+            {
+                failed = true;
+                for (std::thread& t : threads)
+                {
+                    t.join();
+                }
+                throw;
+            }
+            worker();
+            for (std::thread& t : threads)
+            {
+                t.join();
             }
+        }
 
-            formatDocuTable();
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
 
-            stream << s::nl;
+        std::vector<Result> results;
+        results.reserve(count);
+        for (std::optional<ResultImpl>& slot : slots)
+        {
+            results.push_back(std::move(*slot));
         }
+        return results;
+    }
 
-        if (!allOptions.empty() || !allSwitches.empty())
+    template <typename CHAR>
+    void Parser<CHAR>::ParseState::Reset(Parser<CHAR> const& parser)
+    {
+        tokens.clear();
+        scopes.clear();
+        scopes.push_back(&parser);
+        arguments.clear();
+        AddArguments(parser);
+        nextArgument = 0;
+        pendingOption = nullptr;
+        errorOnUnmatchedArguments = parser.IsSetErrorOnUnmatchedArguments();
+        stopped = false;
+    }
+
+    template <typename CHAR>
+    void Parser<CHAR>::ParseState::AddArguments(WithCommandContainer<CHAR> const& scope)
+    {
+        for (auto argIt = scope.ArgumentsBegin(); argIt != scope.ArgumentsEnd(); ++argIt)
         {
-            stream << s::optionsCaption << s::nl;
-            docu.clear();
-            for (Option<CHAR> const* opt : allOptions)
+            arguments.push_back(&*argIt);
+        }
+    }
+
+    template <typename CHAR>
+    Option<CHAR> const* Parser<CHAR>::ParseState::FindOption(typename NameIndex<CHAR>::Key const& key) const
+    {
+        for (WithCommandContainer<CHAR> const* scope : scopes)
+        {
+            if (Option<CHAR> const* opt = scope->FindOption(key))
             {
-                docu.push_back({opt->GetAllNames() + s::nl + s::s + s::s + s::ob + opt->GetArgumentName() + s::cb,
-                                opt->GetDescription()});
+                return opt;
             }
-            for (Switch<CHAR> const* sw : allSwitches)
+        }
+        return nullptr;
+    }
+
+    template <typename CHAR>
+    Switch<CHAR> const* Parser<CHAR>::ParseState::FindSwitch(typename NameIndex<CHAR>::Key const& key) const
+    {
+        for (WithCommandContainer<CHAR> const* scope : scopes)
+        {
+            if (Switch<CHAR> const* swt = scope->FindSwitch(key))
             {
-                docu.push_back({sw->GetAllNames(), sw->GetDescription()});
+                return swt;
             }
+        }
+        return nullptr;
+    }
 
-            formatDocuTable();
+    template <typename CHAR>
+    void Parser<CHAR>::ParseImpl(ResultImpl& res, ParseState& state, int argc, const CHAR* const* argv,
+                                 bool skipFirstArg) const
+    {
+        state.Reset(*this);
 
-            stream << s::nl;
+        bool stopped = false;
+        std::vector<std::filesystem::path> openFiles;
+        for (int argi = skipFirstArg ? 1 : 0; argi < argc; ++argi)
+        {
+            if (!AddToken(res, state, std::basic_string_view<CHAR>{argv[argi]}, argi, stopped, openFiles))
+            {
+                res.BuildIndex();
+                return;
+            }
         }
 
-        if (cmdsCnt > 0)
-        {
-            stream << s::commandsCaption << s::nl;
-            docu.clear();
-            for (auto cmdIt = cmds->CommandsBegin(); cmdIt != cmds->CommandsEnd(); ++cmdIt)
+        ParseTokens(res, state);
+    }
+
+    template <typename CHAR>
+    void Parser<CHAR>::ParseImpl(ResultImpl& res, ParseState& state, std::basic_string_view<CHAR> commandLine,
+                                 bool skipFirstArg) const
+    {
+        state.Reset(*this);
+
+        bool stopped = false;
+        bool ok = true;
+        int position = 0;
+        std::vector<std::filesystem::path> openFiles;
+        const bool tokenized = Tokenizer<CHAR>::Tokenize(
+            commandLine.data(), commandLine.data() + commandLine.size(),
+            [&]()
             {
-                if (cmdIt->DoesHideFromHelp())
+                // Reuse the buffer of the last call, unless a copy of its Result still references it
+                if (!state.textBuffer || state.textBuffer.use_count() > 1)
                 {
-                    continue;
+                    state.textBuffer = std::allocate_shared<std::pmr::basic_string<CHAR>>(
+                        std::pmr::polymorphic_allocator<std::pmr::basic_string<CHAR>>{state.tokens.get_allocator()});
                 }
-                docu.push_back({cmdIt->GetAllNames(), cmdIt->GetDescription()});
-            }
+                state.textBuffer->resize(commandLine.size());
+                res.AddStorage(state.textBuffer);
+                return state.textBuffer->data();
+            },
+            [&](std::basic_string_view<CHAR> token)
+            {
+                const int argi = position++;
+                if (ok && (argi > 0 || !skipFirstArg))
+                {
+                    ok = AddToken(res, state, token, argi, stopped, openFiles);
+                }
+            });
 
-            formatDocuTable();
+        if (!ok)
+        {
+            res.BuildIndex();
+            return;
+        }
+        if (!tokenized)
+        {
+            res.SetError(StringConsts::errorUnterminatedQuote);
+            res.BuildIndex();
+            return;
+        }
 
-            stream << s::nl;
+        ParseTokens(res, state);
+    }
+
+    template <typename CHAR>
+    bool Parser<CHAR>::AddToken(ResultImpl& res, ParseState& state, std::basic_string_view<CHAR> arg, int position,
+                                bool& stopped, std::vector<std::filesystem::path>& openFiles) const
+    {
+        if (m_withResponseFiles && !stopped && arg.size() > 1 && arg[0] == '@')
+        {
+            return ExpandResponseFile(res, state, arg.substr(1), position, stopped, openFiles);
+        }
+        if (arg == StringConsts::parserStopToken)
+        {
+            stopped = true;
         }
+        state.tokens.push_back({arg, position});
+        return true;
     }
 
     template <typename CHAR>
-    typename Parser<CHAR>::Result Parser<CHAR>::Parse(int argc, const CHAR* const* argv,
-                                                      bool skipFirstArg /* = true */) const
+    bool Parser<CHAR>::ExpandResponseFile(ResultImpl& res, ParseState& state, std::basic_string_view<CHAR> path,
+                                          int position, bool& stopped,
+                                          std::vector<std::filesystem::path>& openFiles) const
     {
         using s = StringConsts;
 
-        ResultImpl res{};
+        const std::filesystem::path filePath{std::basic_string<CHAR>{path}};
+        std::error_code ec;
+        std::filesystem::path canonical = std::filesystem::weakly_canonical(filePath, ec);
+        if (ec)
+        {
+            canonical = filePath;
+        }
+        if (std::find(openFiles.begin(), openFiles.end(), canonical) != openFiles.end())
+        {
+            std::basic_string<CHAR> msg{s::errorResponseFileRecursion};
+            msg += path;
+            res.SetError(msg);
+            return false;
+        }
 
-        std::vector<Command<CHAR> const*> allCommands;
-        std::vector<Option<CHAR> const*> allOptions;
-        std::vector<Switch<CHAR> const*> allSwitches;
-        std::vector<Argument<CHAR> const*> allArguments;
-        auto const addRange = [](auto& vec, auto itBegin, auto itEnd)
+        std::shared_ptr<ResponseFile<CHAR>> file = ResponseFile<CHAR>::Open(filePath);
+        if (!file)
         {
-            for (auto optIt = itBegin; optIt != itEnd; ++optIt)
+            std::basic_string<CHAR> msg{s::errorResponseFileRead};
+            msg += path;
+            res.SetError(msg);
+            return false;
+        }
+        res.AddStorage(file);
+
+        openFiles.push_back(std::move(canonical));
+        bool nestedOk = true;
+        const bool tokenized = Tokenizer<CHAR>::Tokenize(
+            file->TextBegin(), file->TextEnd(), [&]() { return file->TextBegin(); },
+            [&](std::basic_string_view<CHAR> token)
             {
-                vec.push_back(&*optIt);
-            }
-        };
+                if (nestedOk)
+                {
+                    nestedOk = AddToken(res, state, token, position, stopped, openFiles);
+                }
+            });
+        openFiles.pop_back();
 
-        Switch<CHAR> helpSwitch{s::helpName, s::helpDescription};
-        helpSwitch.AddAlias(s::helpAlias1).AddAlias(s::helpAlias2).AddAlias(s::helpAlias3).AddAlias(s::helpAlias4);
-        if (m_withImplicitHelpSwitch)
+        if (!nestedOk)
         {
-            allSwitches.push_back(&helpSwitch);
+            return false;
+        }
+        if (!tokenized)
+        {
+            std::basic_string<CHAR> msg{s::errorUnterminatedQuote};
+            msg += s::errorContextSeparator;
+            msg += path;
+            res.SetError(msg);
+            return false;
         }
+        return true;
+    }
 
-        addRange(allCommands, Parser<CHAR>::CommandsBegin(), Parser<CHAR>::CommandsEnd());
-        addRange(allOptions, Parser<CHAR>::OptionsBegin(), Parser<CHAR>::OptionsEnd());
-        addRange(allSwitches, Parser<CHAR>::SwitchesBegin(), Parser<CHAR>::SwitchesEnd());
-        addRange(allArguments, Parser<CHAR>::ArgumentsBegin(), Parser<CHAR>::ArgumentsEnd());
+    template <typename CHAR>
+    typename Parser<CHAR>::TokenMatch Parser<CHAR>::MatchToken(ParseState& state,
+                                                              std::basic_string_view<CHAR> arg) const
+    {
+        using s = StringConsts;
+        using Kind = typename TokenMatch::Kind;
+
+        TokenMatch match{Kind::Unmatched, nullptr, nullptr, nullptr, nullptr, arg};
+
+        if (state.stopped)
+        {
+            return match;
+        }
+        if (arg == s::parserStopToken)
+        {
+            state.stopped = true;
+            match.kind = Kind::StopToken;
+            return match;
+        }
+
+        if (state.pendingOption != nullptr)
+        {
+            match.kind = Kind::OptionValue;
+            match.option = state.pendingOption;
+            state.pendingOption = nullptr;
+            return match;
+        }
 
-        bool errorOnUnmatchedArguments = Parser<CHAR>::IsSetErrorOnUnmatchedArguments();
+        const typename NameIndex<CHAR>::Key key{arg};
 
-        Option<CHAR> const* pendingOption = nullptr;
+        if (Command<CHAR> const* cmd = state.scopes.back()->FindCommand(key))
+        {
+            state.scopes.push_back(cmd);
+            state.AddArguments(*cmd);
 
-        for (int argi = skipFirstArg ? 1 : 0; argi < argc; ++argi)
+            switch (cmd->GetSetErrorOnUnmatchedArguments())
+            {
+                case Command<CHAR>::OnUnmatchedArguments::SetError:
+                    state.errorOnUnmatchedArguments = true;
+                    break;
+                case Command<CHAR>::OnUnmatchedArguments::NoError:
+                    state.errorOnUnmatchedArguments = false;
+                    break;
+                case Command<CHAR>::OnUnmatchedArguments::Keep:
+                    // no change
+                    break;
+                default:
+                    match.kind = Kind::Error;
+                    return match;
+            }
+
+            match.kind = Kind::Command;
+            match.command = cmd;
+            return match;
+        }
+
+        if (Option<CHAR> const* opt = state.FindOption(key))
+        {
+            state.pendingOption = opt;
+            match.kind = Kind::OptionName;
+            match.option = opt;
+            return match;
+        }
+
+        // Option name and value in one argument, e.g. `--opt=value`: probe the name in front of each separator
+        for (size_t sep = arg.find_first_of(s::optionValueSeparators); sep != std::basic_string_view<CHAR>::npos;
+             sep = arg.find_first_of(s::optionValueSeparators, sep + 1))
+        {
+            if (Option<CHAR> const* opt = state.FindOption(typename NameIndex<CHAR>::Key{arg.substr(0, sep)}))
+            {
+                match.kind = Kind::OptionValue;
+                match.option = opt;
+                match.value = arg.substr(sep + 1);
+                return match;
+            }
+        }
+
+        if (m_withImplicitHelpSwitch && m_helpSwitch.IsMatch(arg))
+        {
+            match.kind = Kind::HelpSwitch;
+            return match;
+        }
+        if (Switch<CHAR> const* swt = state.FindSwitch(key))
+        {
+            match.kind = Kind::Switch;
+            match.switchOption = swt;
+            return match;
+        }
+
+        if (state.nextArgument < state.arguments.size())
         {
-            const std::basic_string_view<CHAR> arg{argv[argi]};
-            bool handled = false;
+            match.kind = Kind::Argument;
+            match.argument = state.arguments[state.nextArgument++];
+            return match;
+        }
+
+        return match;
+    }
+
+    template <typename CHAR>
+    void Parser<CHAR>::ParseTokens(ResultImpl& res, ParseState& state) const
+    {
+        using s = StringConsts;
 
-            if (arg == s::parserStopToken)
+        // conversion errors of bound values are already reported to `res`
+        bool conversionFailed = false;
+        // the index of the token is the cache slot of its value
+        uint32_t slot = 0;
+        for (typename ParseState::Token const& token : state.tokens)
+        {
+            const TokenMatch match = MatchToken(state, token.text);
+            const uint32_t tokenSlot = slot++;
+            switch (match.kind)
             {
-                for (argi++; argi < argc; ++argi)
+                case TokenMatch::Kind::StopToken:
+                case TokenMatch::Kind::OptionName:
+                    break;
+                case TokenMatch::Kind::Command:
+                    res.AddCommand(*match.command);
+                    break;
+                case TokenMatch::Kind::OptionValue:
                 {
-                    res.AddUnmatchedArgument(ResultValueViewImpl{std::basic_string_view<CHAR>{argv[argi]},
-                                                                 res.GetErrorInfo(), std::nullopt, argi});
+                    ResultValueViewImpl value{match.value, res.GetErrorInfo(), *match.option, token.position,
+                                              tokenSlot};
+                    if (match.option->IsBound() &&
+                        !match.option->StoreBound(static_cast<ResultValueView const*>(&value)))
+                    {
+                        conversionFailed = true;
+                    }
+                    res.AddOption(std::move(value));
+                }
+                break;
+                case TokenMatch::Kind::Switch:
+                    if (match.switchOption->IsBound())
+                    {
+                        match.switchOption->StoreBound(nullptr);
+                    }
+                    res.AddSwitch(*match.switchOption);
+                    break;
+                case TokenMatch::Kind::HelpSwitch:
+                    res.GetErrorInfo()->SetShouldShowHelp();
+                    break;
+                case TokenMatch::Kind::Argument:
+                {
+                    ResultValueViewImpl value{match.value, res.GetErrorInfo(), *match.argument, token.position,
+                                              tokenSlot};
+                    if (match.argument->IsBound() &&
+                        !match.argument->StoreBound(static_cast<ResultValueView const*>(&value)))
+                    {
+                        conversionFailed = true;
+                    }
+                    res.AddMatchedArgument(std::move(value));
                 }
                 break;
+                case TokenMatch::Kind::Unmatched:
+                    res.AddUnmatchedArgument(
+                        ResultValueViewImpl{match.value, res.GetErrorInfo(), std::nullopt, token.position, tokenSlot});
+                    break;
+                default:
+                    res.SetError(s::errorGenericParserError);
+                    res.BuildIndex();
+                    return;
+            }
+        }
+
+        // the index tells which Options and Switches are missing from the command line
+        res.BuildIndex();
+        if (AddFallbackValues(res, state, slot, conversionFailed))
+        {
+            res.BuildIndex();
+        }
+
+        Argument<CHAR> const* missingRequiredArgument = nullptr;
+        for (size_t i = state.nextArgument; i < state.arguments.size(); ++i)
+        {
+            if (state.arguments[i]->IsRequired())
+            {
+                missingRequiredArgument = state.arguments[i];
+                break;
             }
+        }
+
+        if (state.pendingOption != nullptr)
+        {
+            std::basic_string<CHAR> msg{s::errorOptionNoValue};
+            msg += state.pendingOption->NameAliasBegin()->GetNameView();
+            res.SetError(msg);
+        }
+        else if (state.errorOnUnmatchedArguments && res.HasUnmatchedArguments())
+        {
+            res.SetError(s::errorUnmatchedArguments);
+        }
+        else if (missingRequiredArgument != nullptr)
+        {
+            std::basic_string<CHAR> msg{s::errorRequiredArgumentMissing};
+            msg += missingRequiredArgument->GetNameView();
+            res.SetError(msg);
+        }
+        else if (!conversionFailed)
+        {
+            res.GetErrorInfo()->SetSuccess();
+        }
+    }
+
+    template <typename CHAR>
+    bool Parser<CHAR>::AddFallbackValues(ResultImpl& res, ParseState const& state, uint32_t slot,
+                                         bool& conversionFailed) const
+    {
+        std::shared_ptr<const Environment<CHAR>> env;
+        bool addedFromEnvironment = false;
+        bool addedFromConfigFile = false;
 
-            if (pendingOption != nullptr)
+        // stores the value of an Option, or sets a Switch if its value is true
+        auto addOptionValue = [&](Option<CHAR> const& opt, ResultValueViewImpl&& value)
+        {
+            if (opt.IsBound() && !opt.StoreBound(static_cast<ResultValueView const*>(&value)))
             {
-                res.AddOption(ResultValueViewImpl{arg, res.GetErrorInfo(), *pendingOption, argi});
-                handled = true;
-                pendingOption = nullptr;
+                conversionFailed = true;
             }
-            if (handled)
+            res.AddOption(std::move(value));
+        };
+        auto addSwitchValue = [&](Switch<CHAR> const& swt, ResultValueViewImpl&& value)
+        {
+            std::optional<bool> isSet = value.empty() ? std::optional<bool>{true} : value.AsBool();
+            if (!isSet.has_value())
             {
-                continue;
+                conversionFailed = true;
+                return;
             }
-
-            for (Command<CHAR> const* cmd : allCommands)
+            if (isSet.value())
             {
-                if (cmd->IsMatch(arg))
+                if (swt.IsBound())
                 {
-                    allCommands.clear();
-                    addRange(allCommands, cmd->CommandsBegin(), cmd->CommandsEnd());
+                    swt.StoreBound(nullptr);
+                }
+                res.AddSwitch(swt);
+            }
+        };
 
-                    addRange(allOptions, cmd->OptionsBegin(), cmd->OptionsEnd());
-                    addRange(allSwitches, cmd->SwitchesBegin(), cmd->SwitchesEnd());
-                    addRange(allArguments, cmd->ArgumentsBegin(), cmd->ArgumentsEnd());
+        for (size_t s = 0; s < state.scopes.size(); ++s)
+        {
+            WithCommandContainer<CHAR> const* scope = state.scopes[s];
+            const bool withEnvironment = scope->HasEnvironmentFallbacks();
+            if (!withEnvironment && m_configFiles.empty())
+            {
+                continue;
+            }
+            if (withEnvironment && !env)
+            {
+                env = m_environment ? m_environment : Environment<CHAR>::Process();
+            }
+            // the first scope is the parser itself, all others are the path of nested commands
+            WithCommandContainer<CHAR> const* const* pathBegin = state.scopes.data() + 1;
+            WithCommandContainer<CHAR> const* const* pathEnd = state.scopes.data() + s + 1;
 
-                    switch (cmd->GetSetErrorOnUnmatchedArguments())
+            for (auto opt = scope->OptionsBegin(); opt != scope->OptionsEnd(); ++opt)
+            {
+                if (res.GetOptionCount(*opt) > 0)
+                {
+                    continue;
+                }
+                if (withEnvironment && opt->HasEnvironmentName())
+                {
+                    std::optional<std::basic_string_view<CHAR>> str = env->Find(opt->GetEnvironmentName());
+                    if (str.has_value())
                     {
-                        case Command<CHAR>::OnUnmatchedArguments::SetError:
-                            errorOnUnmatchedArguments = true;
-                            break;
-                        case Command<CHAR>::OnUnmatchedArguments::NoError:
-                            errorOnUnmatchedArguments = false;
-                            break;
-                        case Command<CHAR>::OnUnmatchedArguments::Keep:
-                            // no change
-                            break;
-                        default:
-                            res.SetError(s::errorGenericParserError);
-                            return res;
+                        addOptionValue(*opt, ResultValueViewImpl{str.value(), res.GetErrorInfo(), *opt, -1, slot++,
+                                                                 ValueOrigin::Environment});
+                        addedFromEnvironment = true;
+                        continue;
                     }
-
-                    res.AddCommand(*cmd);
-                    handled = true;
-                    break;
                 }
-            }
-            if (handled)
-            {
-                continue;
+                addedFromConfigFile |=
+                    ForEachConfigEntry(*opt, pathBegin, pathEnd, [&](typename ConfigFile<CHAR>::Entry const& e) {
+                        addOptionValue(*opt, ResultValueViewImpl{e.value, res.GetErrorInfo(), *opt, e.line, slot++,
+                                                                 ValueOrigin::ConfigFile});
+                    });
             }
 
-            for (Option<CHAR> const* opt : allOptions)
+            for (auto swt = scope->SwitchesBegin(); swt != scope->SwitchesEnd(); ++swt)
             {
-                if (opt->IsMatch(arg))
+                if (res.HasSwitch(*swt) > 0)
                 {
-                    pendingOption = opt;
-                    handled = true;
-                    break;
+                    continue;
                 }
-                std::basic_string_view<CHAR> valueStr;
-                if (opt->IsMatchWithValue(arg, valueStr))
+                if (withEnvironment && swt->HasEnvironmentName())
                 {
-                    handled = true;
-                    res.AddOption(ResultValueViewImpl{valueStr, res.GetErrorInfo(), *opt, argi});
-                    break;
+                    std::optional<std::basic_string_view<CHAR>> str = env->Find(swt->GetEnvironmentName());
+                    if (str.has_value())
+                    {
+                        addSwitchValue(*swt, ResultValueViewImpl{str.value(), res.GetErrorInfo(), *swt, -1, slot++,
+                                                                 ValueOrigin::Environment});
+                        addedFromEnvironment = true;
+                        continue;
+                    }
                 }
+                addedFromConfigFile |=
+                    ForEachConfigEntry(*swt, pathBegin, pathEnd, [&](typename ConfigFile<CHAR>::Entry const& e) {
+                        addSwitchValue(*swt, ResultValueViewImpl{e.value, res.GetErrorInfo(), *swt, e.line, slot++,
+                                                                 ValueOrigin::ConfigFile});
+                    });
             }
-            if (handled)
+        }
+
+        // the values point into the environment snapshot and the config files
+        if (addedFromEnvironment)
+        {
+            res.AddStorage(std::move(env));
+        }
+        if (addedFromConfigFile)
+        {
+            for (std::shared_ptr<const ConfigFile<CHAR>> const& file : m_configFiles)
+            {
+                res.AddStorage(file);
+            }
+        }
+        return addedFromEnvironment || addedFromConfigFile;
+    }
+
+    template <typename CHAR>
+    template <typename T, typename F>
+    bool Parser<CHAR>::ForEachConfigEntry(T const& obj, WithCommandContainer<CHAR> const* const* pathBegin,
+                                          WithCommandContainer<CHAR> const* const* pathEnd, F&& func) const
+    {
+        for (auto file = m_configFiles.crbegin(); file != m_configFiles.crend(); ++file)
+        {
+            const uint32_t section = (*file)->FindSection(pathBegin, pathEnd);
+            if (section == ConfigFile<CHAR>::npos)
             {
                 continue;
             }
-            for (Switch<CHAR> const* swt : allSwitches)
+            bool found = false;
+            for (const Alias<CHAR>* a = obj.NameAliasBegin(); a != obj.NameAliasEnd(); ++a)
             {
-                if (swt->IsMatch(arg))
+                const std::basic_string_view<CHAR> key = ConfigFile<CHAR>::KeyOf(a->GetNameView());
+                const bool caseSensitive = a->GetStringCompareMode() == Alias<CHAR>::StringCompare::CaseSensitive;
+                for (auto e = (*file)->FindFirst(section, key); e != nullptr; e = (*file)->Next(*e))
                 {
-                    handled = true;
-                    if (WithIdentity<CHAR>::Equals(*swt, helpSwitch))
-                    {
-                        res.GetErrorInfo()->SetShouldShowHelp();
-                    }
-                    else
+                    // the file is indexed ignoring case
+                    if (caseSensitive && e->key != key)
                     {
-                        res.AddSwitch(*swt);
+                        continue;
                     }
-                    break;
+                    func(*e);
+                    found = true;
                 }
             }
-            if (handled)
+            if (found)
             {
-                continue;
+                return true;
             }
+        }
+        return false;
+    }
 
-            if (!allArguments.empty())
-            {
-                Argument<CHAR> const* ma = allArguments.front();
-                res.AddMatchedArgument(ResultValueViewImpl{arg, res.GetErrorInfo(), *ma, argi});
-                handled = true;
-                allArguments.erase(allArguments.begin());
-            }
-            if (handled)
-            {
-                continue;
-            }
+    template <typename CHAR>
+    std::pmr::vector<std::basic_string_view<CHAR>> const& Parser<CHAR>::Completion::Complete(
+        int argc, const CHAR* const* argv, int cursor, bool skipFirstArg)
+    {
+        const int first = skipFirstArg ? 1 : 0;
+        cursor = (std::max)(first, (std::min)(cursor, argc));
 
-            res.AddUnmatchedArgument(ResultValueViewImpl{arg, res.GetErrorInfo(), std::nullopt, argi});
+        // Keep the state of the unchanged prefix of the previous command line
+        size_t same = 0;
+        while (same < m_consumed.size() && first + static_cast<int>(same) < cursor &&
+               m_consumed[same] == argv[first + same])
+        {
+            ++same;
         }
+        Rewind(same);
 
-        Argument<CHAR> const* missingRequiredArgument = nullptr;
-        for (Argument<CHAR> const* ma : allArguments)
+        for (int argi = first + static_cast<int>(same); argi < cursor; ++argi)
+        {
+            m_steps.push_back(Step{m_state.scopes.size(), m_state.arguments.size(), m_state.nextArgument,
+                                   m_state.pendingOption, m_state.errorOnUnmatchedArguments, m_state.stopped});
+            m_consumed.emplace_back(argv[argi]);
+            m_parser.MatchToken(m_state, m_consumed.back());
+        }
+
+        m_candidates.clear();
+        if (m_state.stopped || m_state.pendingOption != nullptr)
+        {
+            return m_candidates;
+        }
+
+        const std::basic_string_view<CHAR> prefix =
+            (cursor < argc) ? std::basic_string_view<CHAR>{argv[cursor]} : std::basic_string_view<CHAR>{};
+
+        WithCommandContainer<CHAR> const* scope = m_state.scopes.back();
+        for (auto cmdIt = scope->CommandsBegin(); cmdIt != scope->CommandsEnd(); ++cmdIt)
+        {
+            AddCandidates(*cmdIt, prefix);
+        }
+        for (WithCommandContainer<CHAR> const* s : m_state.scopes)
         {
-            if (ma->IsRequired())
+            for (auto optIt = s->OptionsBegin(); optIt != s->OptionsEnd(); ++optIt)
             {
-                missingRequiredArgument = ma;
-                break;
+                AddCandidates(*optIt, prefix);
+            }
+            for (auto swtIt = s->SwitchesBegin(); swtIt != s->SwitchesEnd(); ++swtIt)
+            {
+                AddCandidates(*swtIt, prefix);
             }
         }
-
-        if (pendingOption != nullptr)
+        if (m_parser.m_withImplicitHelpSwitch)
         {
-            std::basic_string<CHAR> msg{s::errorOptionNoValue};
-            msg += pendingOption->NameAliasBegin()->GetName();
-            res.SetError(msg);
+            AddCandidates(m_parser.m_helpSwitch, prefix);
         }
-        else if (errorOnUnmatchedArguments && res.HasUnmatchedArguments())
+
+        return m_candidates;
+    }
+
+    template <typename CHAR>
+    void Parser<CHAR>::Completion::Rewind(size_t count)
+    {
+        if (count == m_consumed.size())
         {
-            res.SetError(s::errorUnmatchedArguments);
+            return;
         }
-        else if (missingRequiredArgument != nullptr)
+        if (count == 0)
         {
-            std::basic_string<CHAR> msg{s::errorRequiredArgumentMissing};
-            msg += missingRequiredArgument->GetName();
-            res.SetError(msg);
+            m_state.Reset(m_parser);
         }
         else
         {
-            res.GetErrorInfo()->SetSuccess();
+            Step const& step = m_steps[count];
+            m_state.scopes.resize(step.scopeCount);
+            m_state.arguments.resize(step.argumentCount);
+            m_state.nextArgument = step.nextArgument;
+            m_state.pendingOption = step.pendingOption;
+            m_state.errorOnUnmatchedArguments = step.errorOnUnmatchedArguments;
+            m_state.stopped = step.stopped;
         }
+        m_consumed.resize(count);
+        m_steps.resize(count);
+    }
 
-        return res;
+    template <typename CHAR>
+    template <typename ITEM>
+    void Parser<CHAR>::Completion::AddCandidates(ITEM const& item, std::basic_string_view<CHAR> prefix)
+    {
+        if (item.DoesHideFromHelp())
+        {
+            return;
+        }
+        for (auto aliasIt = item.NameAliasBegin(); aliasIt != item.NameAliasEnd(); ++aliasIt)
+        {
+            if (aliasIt->IsPrefix(prefix))
+            {
+                m_candidates.push_back(aliasIt->GetNameView());
+            }
+        }
+    }
+
+    template <typename CHAR>
+    typename Parser<CHAR>::Result& Parser<CHAR>::Session::Parse(int argc, const CHAR* const* argv, bool skipFirstArg)
+    {
+        m_result.Clear();
+        m_parser.ParseImpl(m_result, m_state, argc, argv, skipFirstArg);
+        return m_result;
+    }
+
+    template <typename CHAR>
+    typename Parser<CHAR>::Result& Parser<CHAR>::Session::Parse(std::basic_string_view<CHAR> commandLine,
+                                                                bool skipFirstArg)
+    {
+        m_result.Clear();
+        m_parser.ParseImpl(m_result, m_state, commandLine, skipFirstArg);
+        return m_result;
     }
 
     template <>
@@ -2095,196 +6564,212 @@ namespace yaclap
     }
 
     template <typename CHAR>
-    std::optional<long long> Parser<CHAR>::ResultValueView::AsInteger(bool errorWhenTypeParingFails) const
+    template <typename T>
+    std::optional<T> Parser<CHAR>::ResultValueView::ConvertInteger(bool errorWhenTypeParingFails) const
     {
-        long long limit = (std::numeric_limits<long long>::max)() / 10;
-
         using s = StringConsts;
-        long long v = 0;
-        long long base = 10;
-        bool neg = false;
+        using P = NumberParser<CHAR>;
 
-        enum class State
+        typename P::IntegerParts parts;
+        typename ResultErrorInfo::Conversions* cache = GetConversions();
+        if (cache != nullptr && (cache->done & ResultErrorInfo::Conversions::Integer) != 0)
         {
-            SignPrefixOrValue = 0,
-            PrefixOrValue = 1,
-            Value = 2
-        };
-        State state = State::SignPrefixOrValue;
+            parts = cache->integer;
+        }
+        else
+        {
+            const CHAR* b = std::basic_string_view<CHAR>::data();
+            const CHAR* e = b + std::basic_string_view<CHAR>::size();
+            P::Trim(b, e);
+            parts = P::ParseIntegerParts(b, e);
+            if (cache != nullptr)
+            {
+                cache->integer = parts;
+                cache->done |= ResultErrorInfo::Conversions::Integer;
+            }
+        }
 
-        auto strRange = ResultValueView::GetStringTrimmed();
+        T value{};
+        switch ((parts.status == P::Status::Ok) ? P::ToInteger(parts, value) : parts.status)
+        {
+            case P::Status::Ok:
+                return value;
+            case P::Status::MissingInput:
+                ReportConversionError(errorWhenTypeParingFails, s::errorMissingInput);
+                break;
+            case P::Status::UnexpectedChar:
+                ReportConversionError(errorWhenTypeParingFails, s::errorParserUnexpectedCharAt, parts.errorAt + 1);
+                break;
+            case P::Status::DataTypeLimit:
+                ReportConversionError(errorWhenTypeParingFails, s::errorDataTypeLimit);
+                break;
+        }
+        return std::nullopt;
+    }
+
+    template <typename CHAR>
+    template <typename T>
+    std::optional<size_t> Parser<CHAR>::ResultValueView::ConvertList(T* out, size_t capacity, CHAR delimiter,
+                                                                     bool errorWhenTypeParingFails) const
+    {
+        using s = StringConsts;
+        using P = NumberParser<CHAR>;
 
-        for (auto strIt = strRange.first; strIt != strRange.second; ++strIt)
+        size_t count = 0;
+        for (std::basic_string_view<CHAR> element : Split(delimiter))
         {
-            char c = s::asChar(*strIt);
-            switch (state)
+            if (count == capacity)
             {
-                case State::SignPrefixOrValue:
-                    if (c == '+')
-                    {
-                        state = State::PrefixOrValue;
-                        continue;
-                    }
-                    if (c == '-')
-                    {
-                        state = State::PrefixOrValue;
-                        neg = true;
-                        continue;
-                    }
-                    [[fallthrough]];
-                case State::PrefixOrValue:
-                    if (c == 'x' || c == 'X')
-                    {
-                        base = 16;
-                        limit = (std::numeric_limits<long long>::max)() / 16;
-                        state = State::Value;
-                        continue;
-                    }
-                    if (c == 'o' || c == 'O')
-                    {
-                        base = 8;
-                        limit = (std::numeric_limits<long long>::max)() / 8;
-                        state = State::Value;
-                        continue;
-                    }
-                    if (c == 'b' || c == 'B')
-                    {
-                        base = 2;
-                        limit = (std::numeric_limits<long long>::max)() / 2;
-                        state = State::Value;
-                        continue;
-                    }
-                    [[fallthrough]];
-                case State::Value:
-                    if (c >= '0' && c <= '1')
-                    {
-                        if (v >= limit)
-                        {
-                            std::basic_string<CHAR> msg{s::errorParserValueConversion};
-                            msg += s::to_string(ResultValueView::GetPosition());
-                            msg += s::errorContextSeparator;
-                            msg += s::errorDataTypeLimit;
-                            m_errorInfo->SetError(msg);
-                            return std::nullopt;
-                        }
-                        v = v * base + static_cast<int>(c - '0');
-                        state = State::Value;
-                        continue;
-                    }
-                    if (base >= 8 && c >= '2' && c <= '7')
-                    {
-                        if (v >= limit)
-                        {
-                            std::basic_string<CHAR> msg{s::errorParserValueConversion};
-                            msg += s::to_string(ResultValueView::GetPosition());
-                            msg += s::errorContextSeparator;
-                            msg += s::errorDataTypeLimit;
-                            m_errorInfo->SetError(msg);
-                            return std::nullopt;
-                        }
-                        v = v * base + static_cast<int>(c - '0');
-                        state = State::Value;
-                        continue;
-                    }
-                    if (base >= 10 && c >= '8' && c <= '9')
-                    {
-                        if (v >= limit)
-                        {
-                            std::basic_string<CHAR> msg{s::errorParserValueConversion};
-                            msg += s::to_string(ResultValueView::GetPosition());
-                            msg += s::errorContextSeparator;
-                            msg += s::errorDataTypeLimit;
-                            m_errorInfo->SetError(msg);
-                            return std::nullopt;
-                        }
-                        v = v * base + static_cast<int>(c - '0');
-                        state = State::Value;
-                        continue;
-                    }
-                    if (base == 16 && (c >= 'a' && c <= 'f'))
-                    {
-                        if (v >= limit)
-                        {
-                            std::basic_string<CHAR> msg{s::errorParserValueConversion};
-                            msg += s::to_string(ResultValueView::GetPosition());
-                            msg += s::errorContextSeparator;
-                            msg += s::errorDataTypeLimit;
-                            m_errorInfo->SetError(msg);
-                            return std::nullopt;
-                        }
-                        v = v * base + (10 + static_cast<int>(c - 'a'));
-                        state = State::Value;
-                        continue;
-                    }
-                    if (base == 16 && (c >= 'A' && c <= 'F'))
+                ReportConversionError(errorWhenTypeParingFails, s::errorListCapacity, 0, count + 1);
+                return std::nullopt;
+            }
+            const CHAR* b = element.data();
+            const CHAR* e = b + element.size();
+            P::Trim(b, e);
+
+            size_t errorAt = 0;
+            typename P::Status status;
+            if constexpr (std::is_integral_v<T>)
+            {
+                status = P::ParseInteger(b, e, out[count], errorAt);
+            }
+            else
+            {
+                status = P::ParseFloat(b, e, out[count], errorAt);
+            }
+            ++count;
+            switch (status)
+            {
+                case P::Status::Ok:
+                    continue;
+                case P::Status::MissingInput:
+                    ReportConversionError(errorWhenTypeParingFails, s::errorMissingInput, 0, count);
+                    break;
+                case P::Status::UnexpectedChar:
+                    ReportConversionError(errorWhenTypeParingFails, s::errorParserUnexpectedCharAt, errorAt + 1, count);
+                    break;
+                case P::Status::DataTypeLimit:
+                    ReportConversionError(errorWhenTypeParingFails, s::errorDataTypeLimit, 0, count);
+                    break;
+            }
+            return std::nullopt;
+        }
+        return count;
+    }
+
+    template <typename CHAR>
+    std::optional<RangeList> Parser<CHAR>::ResultValueView::AsRangeList(uint64_t maxValue, CHAR delimiter,
+                                                                        bool errorWhenTypeParingFails) const
+    {
+        using s = StringConsts;
+        using P = NumberParser<CHAR>;
+
+        RangeList ranges;
+        size_t index = 0;
+        for (std::basic_string_view<CHAR> element : Split(delimiter))
+        {
+            ++index;
+            const CHAR* b = element.data();
+            const CHAR* e = b + element.size();
+            P::Trim(b, e);
+
+            // the range separator can not be the first character, which might be a sign
+            const CHAR* dash = (b == e) ? e : std::find(b + 1, e, static_cast<CHAR>('-'));
+            const CHAR* firstEnd = dash;
+            const CHAR* lastBegin = (dash == e) ? b : dash + 1;
+            P::Trim(b, firstEnd);
+            P::Trim(lastBegin, e);
+
+            uint64_t bounds[2];
+            const CHAR* texts[2][2] = {{b, firstEnd}, {lastBegin, e}};
+            for (int i = 0; i < 2; ++i)
+            {
+                size_t errorAt = 0;
+                const typename P::Status status = P::ParseInteger(texts[i][0], texts[i][1], bounds[i], errorAt);
+                if (status == P::Status::Ok && bounds[i] <= maxValue)
+                {
+                    continue;
+                }
+                switch (status)
+                {
+                    case P::Status::Ok:
                     {
-                        if (v >= limit)
+                        if (errorWhenTypeParingFails && m_errorInfo != nullptr)
                         {
-                            std::basic_string<CHAR> msg{s::errorParserValueConversion};
-                            msg += s::to_string(ResultValueView::GetPosition());
-                            msg += s::errorContextSeparator;
-                            msg += s::errorDataTypeLimit;
-                            m_errorInfo->SetError(msg);
-                            return std::nullopt;
+                            std::basic_string<CHAR> reason{s::errorRangeBounds};
+                            reason += s::to_string(maxValue);
+                            ReportConversionError(errorWhenTypeParingFails, reason.c_str(), 0, index);
                         }
-                        v = v * base + (10 + static_cast<int>(c - 'A'));
-                        state = State::Value;
-                        continue;
                     }
                     break;
-
-                default:
-                {
-                    std::basic_string<CHAR> msg{s::errorParserValueConversion};
-                    msg += s::to_string(ResultValueView::GetPosition());
-                    msg += s::errorContextSeparator;
-                    msg += s::errorGenericParserError;
-                    m_errorInfo->SetError(msg);
+                    case P::Status::MissingInput:
+                        ReportConversionError(errorWhenTypeParingFails, s::errorMissingInput, 0, index);
+                        break;
+                    case P::Status::UnexpectedChar:
+                        ReportConversionError(errorWhenTypeParingFails, s::errorParserUnexpectedCharAt,
+                                              static_cast<size_t>(texts[i][0] - element.data()) + errorAt + 1, index);
+                        break;
+                    case P::Status::DataTypeLimit:
+                        ReportConversionError(errorWhenTypeParingFails, s::errorDataTypeLimit, 0, index);
+                        break;
                 }
-                    return std::nullopt;
+                return std::nullopt;
             }
-
+            if (bounds[1] < bounds[0])
             {
-                std::basic_string<CHAR> msg{s::errorParserValueConversion};
-                msg += s::to_string(ResultValueView::GetPosition());
-                msg += s::errorContextSeparator;
-                msg += s::errorParserUnexpectedCharAt;
-                msg += s::to_string(1 + strIt - strRange.first);
-                m_errorInfo->SetError(msg);
+                ReportConversionError(errorWhenTypeParingFails, s::errorRangeOrder, 0, index);
+                return std::nullopt;
             }
-            return std::nullopt;
+            ranges.Add(bounds[0], bounds[1]);
         }
+        ranges.Normalize();
+        return ranges;
+    }
+
+    template <typename CHAR>
+    std::optional<bool> Parser<CHAR>::ResultValueView::AsBool(bool errorWhenTypeParingFails) const
+    {
+        using Status = typename NumberParser<CHAR>::Status;
 
-        if (state != State::Value)
+        Status status;
+        bool value = false;
+        typename ResultErrorInfo::Conversions* cache = GetConversions();
+        if (cache != nullptr && (cache->done & ResultErrorInfo::Conversions::Bool) != 0)
         {
-            std::basic_string<CHAR> msg{s::errorParserValueConversion};
-            msg += s::to_string(ResultValueView::GetPosition());
-            msg += s::errorContextSeparator;
-            msg += s::errorMissingInput;
-            m_errorInfo->SetError(msg);
-            return std::nullopt;
+            status = cache->boolStatus;
+            value = cache->boolValue;
+        }
+        else
+        {
+            status = ParseBool(value);
+            if (cache != nullptr)
+            {
+                cache->boolStatus = status;
+                cache->boolValue = value;
+                cache->done |= ResultErrorInfo::Conversions::Bool;
+            }
         }
 
-        if (neg)
+        if (status == Status::Ok)
         {
-            v = -v;
+            return value;
         }
-        return v;
+        ReportConversionError(errorWhenTypeParingFails, (status == Status::MissingInput)
+                                                            ? StringConsts::errorMissingInput
+                                                            : StringConsts::errorUnexpectedInput);
+        return std::nullopt;
     }
 
     template <typename CHAR>
-    std::optional<bool> Parser<CHAR>::ResultValueView::AsBool(bool errorWhenTypeParingFails) const
+    typename NumberParser<CHAR>::Status Parser<CHAR>::ResultValueView::ParseBool(bool& value) const
     {
+        using Status = typename NumberParser<CHAR>::Status;
+
         auto strRange = ResultValueView::GetStringTrimmed();
 
         if (strRange.first == strRange.second)
         {
-            std::basic_string<CHAR> msg{StringConsts::errorParserValueConversion};
-            msg += StringConsts::to_string(ResultValueView::GetPosition());
-            msg += StringConsts::errorContextSeparator;
-            msg += StringConsts::errorMissingInput;
-            m_errorInfo->SetError(msg);
-            return std::nullopt;
+            return Status::MissingInput;
         }
 
         if (strRange.second - strRange.first <= 5)
@@ -2300,193 +6785,71 @@ namespace yaclap
             if (std::memcmp(s, "true", 4) == 0 || std::memcmp(s, "t", 1) == 0 || std::memcmp(s, "on", 2) == 0 ||
                 std::memcmp(s, "yes", 3) == 0 || std::memcmp(s, "y", 1) == 0)
             {
-                return true;
+                value = true;
+                return Status::Ok;
             }
             if (std::memcmp(s, "false", 5) == 0 || std::memcmp(s, "f", 1) == 0 || std::memcmp(s, "off", 3) == 0 ||
                 std::memcmp(s, "no", 2) == 0 || std::memcmp(s, "n", 1) == 0)
             {
-                return false;
+                value = false;
+                return Status::Ok;
             }
         }
 
-        auto intVal = ResultValueView::AsInteger(errorWhenTypeParingFails);
+        auto intVal = ResultValueView::ConvertInteger<long long>(false);
         if (intVal.has_value())
         {
-            return intVal.value() != 0;
+            value = intVal.value() != 0;
+            return Status::Ok;
         }
-
-        std::basic_string<CHAR> msg{StringConsts::errorParserValueConversion};
-        msg += StringConsts::to_string(ResultValueView::GetPosition());
-        msg += StringConsts::errorContextSeparator;
-        msg += StringConsts::errorUnexpectedInput;
-        m_errorInfo->SetError(msg);
-
-        return std::nullopt;
+        return Status::UnexpectedChar;
     }
 
     template <typename CHAR>
-    std::optional<double> Parser<CHAR>::ResultValueView::AsDouble(bool errorWhenTypeParingFails) const
+    template <typename T>
+    std::optional<T> Parser<CHAR>::ResultValueView::ConvertFloat(bool errorWhenTypeParingFails) const
     {
         using s = StringConsts;
+        using P = NumberParser<CHAR>;
 
-        constexpr const long long limit = (std::numeric_limits<long long>::max)() / 10;
-
-        bool negVal = false;
-        long long fullVal = 0;
-        long long fracVal = 0;
-        long long fracWidth = 1;
-        bool negExp = false;
-        long expVal = 0;
-
-        // [+-]?[0..9]*\.?[0..9]*([eE][+-]?[0..9]+)?
-        // 0    1         2           3    4
-        enum class State
+        typename ResultErrorInfo::Conversions::template Floating<T> result;
+        typename ResultErrorInfo::Conversions* cache = GetConversions();
+        const uint8_t flag = std::is_same_v<T, float> ? ResultErrorInfo::Conversions::Float
+                                                      : ResultErrorInfo::Conversions::Double;
+        if (cache != nullptr && (cache->done & flag) != 0)
         {
-            SignOrFullVal = 0,
-            FullVal = 1,
-            FracVal = 2,
-            ExpSignOrVal = 3,
-            ExpVal = 4
-        };
-        State state = State::SignOrFullVal;
-
-        auto strRange = ResultValueView::GetStringTrimmed();
-
-        for (auto strIt = strRange.first; strIt != strRange.second; ++strIt)
+            result = cache->template Get<T>();
+        }
+        else
         {
-            char c = s::asChar(*strIt);
-            switch (state)
-            {
-                case State::SignOrFullVal:
-                    if (c == '+')
-                    {
-                        state = State::FullVal;
-                        continue;
-                    }
-                    if (c == '-')
-                    {
-                        negVal = true;
-                        state = State::FullVal;
-                        continue;
-                    }
-                    [[fallthrough]];
-                case State::FullVal:
-                    if (c >= '0' && c <= '9')
-                    {
-                        if (fullVal >= limit)
-                        {
-                            std::basic_string<CHAR> msg{s::errorParserValueConversion};
-                            msg += s::to_string(ResultValueView::GetPosition());
-                            msg += s::errorContextSeparator;
-                            msg += s::errorDataTypeLimit;
-                            m_errorInfo->SetError(msg);
-                            return std::nullopt;
-                        }
-                        state = State::FullVal;
-                        fullVal *= 10;
-                        fullVal += c - '0';
-                        continue;
-                    }
-                    if (c == '.')
-                    {
-                        state = State::FracVal;
-                        continue;
-                    }
-                    if (c == 'e' || c == 'E')
-                    {
-                        state = State::ExpSignOrVal;
-                        continue;
-                    }
-                    break;
-                case State::FracVal:
-                    if (c >= '0' && c <= '9')
-                    {
-                        if (fracVal < limit)
-                        {
-                            fracWidth *= 10;
-                            fracVal *= 10;
-                            fracVal += c - '0';
-                        }
-                        continue;
-                    }
-                    if (c == 'e' || c == 'E')
-                    {
-                        state = State::ExpSignOrVal;
-                        continue;
-                    }
-                    break;
-                case State::ExpSignOrVal:
-                    if (c == '+')
-                    {
-                        state = State::ExpVal;
-                        continue;
-                    }
-                    if (c == '-')
-                    {
-                        negExp = true;
-                        state = State::ExpVal;
-                        continue;
-                    }
-                    [[fallthrough]];
-                case State::ExpVal:
-                    if (c >= '0' && c <= '9')
-                    {
-                        if (expVal >= limit)
-                        {
-                            std::basic_string<CHAR> msg{s::errorParserValueConversion};
-                            msg += s::to_string(ResultValueView::GetPosition());
-                            msg += s::errorContextSeparator;
-                            msg += s::errorDataTypeLimit;
-                            m_errorInfo->SetError(msg);
-                            return std::nullopt;
-                        }
-                        expVal *= 10;
-                        expVal += c - '0';
-                        continue;
-                    }
-                    break;
-
-                default:
-                {
-                    std::basic_string<CHAR> msg{s::errorParserValueConversion};
-                    msg += s::to_string(ResultValueView::GetPosition());
-                    msg += s::errorContextSeparator;
-                    msg += s::errorGenericParserError;
-                    m_errorInfo->SetError(msg);
-                }
-                    return std::nullopt;
-            }
-
+            const CHAR* b = std::basic_string_view<CHAR>::data();
+            const CHAR* e = b + std::basic_string_view<CHAR>::size();
+            P::Trim(b, e);
+            result.value = T{};
+            result.errorAt = 0;
+            result.status = P::ParseFloat(b, e, result.value, result.errorAt);
+            if (cache != nullptr)
             {
-                std::basic_string<CHAR> msg{s::errorParserValueConversion};
-                msg += s::to_string(ResultValueView::GetPosition());
-                msg += s::errorContextSeparator;
-                msg += s::errorParserUnexpectedCharAt;
-                msg += s::to_string(1 + strIt - strRange.first);
-                m_errorInfo->SetError(msg);
+                cache->template Get<T>() = result;
+                cache->done |= flag;
             }
-            return std::nullopt;
-        }
-
-        if (state < State::FullVal || state > State::ExpVal)
-        {
-            std::basic_string<CHAR> msg{s::errorParserValueConversion};
-            msg += s::to_string(ResultValueView::GetPosition());
-            msg += s::errorContextSeparator;
-            msg += s::errorMissingInput;
-            m_errorInfo->SetError(msg);
-            return std::nullopt;
         }
 
-        double d = static_cast<double>(fullVal) + static_cast<double>(fracVal) / static_cast<double>(fracWidth);
-        const double e = std::pow(10.0, static_cast<double>(negExp ? -expVal : expVal));
-        d *= e;
-        if (negVal)
+        switch (result.status)
         {
-            d = -d;
+            case P::Status::Ok:
+                return result.value;
+            case P::Status::MissingInput:
+                ReportConversionError(errorWhenTypeParingFails, s::errorMissingInput);
+                break;
+            case P::Status::UnexpectedChar:
+                ReportConversionError(errorWhenTypeParingFails, s::errorParserUnexpectedCharAt, result.errorAt + 1);
+                break;
+            case P::Status::DataTypeLimit:
+                ReportConversionError(errorWhenTypeParingFails, s::errorDataTypeLimit);
+                break;
         }
-
-        return d;
+        return std::nullopt;
     }
 
 } // namespace yaclap
@@ -0,0 +1,198 @@
+#include "allocationCounter.hpp"
+
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace yaclap_test
+{
+
+    namespace
+    {
+        // the innermost counter of the thread
+        thread_local AllocationCounter* t_counter = nullptr;
+    } // namespace
+
+    AllocationCounter::AllocationCounter() noexcept
+        : m_outer{t_counter}
+    {
+        t_counter = this;
+    }
+
+    AllocationCounter::~AllocationCounter()
+    {
+        t_counter = m_outer;
+    }
+
+    void AllocationCounter::Record(size_t bytes) noexcept
+    {
+        for (AllocationCounter* c = t_counter; c != nullptr; c = c->m_outer)
+        {
+            c->m_allocations++;
+            c->m_bytes += bytes;
+        }
+    }
+
+} // namespace yaclap_test
+
+void* operator new(std::size_t size)
+{
+    yaclap_test::AllocationCounter::Record(size);
+    if (size == 0)
+    {
+        size = 1;
+    }
+    for (;;)
+    {
+        if (void* p = std::malloc(size))
+        {
+            return p;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr)
+        {
+            throw std::bad_alloc{};
+        }
+        handler();
+    }
+}
+
+void* operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    try
+    {
+        return ::operator new(size);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return ::operator new(size, std::nothrow);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    yaclap_test::AllocationCounter::Record(size);
+    const std::size_t align = static_cast<std::size_t>(alignment);
+    // aligned_alloc requires the size to be a multiple of the alignment
+    size = (size + align - 1) / align * align;
+    if (size == 0)
+    {
+        size = align;
+    }
+    for (;;)
+    {
+#ifdef _WIN32
+        if (void* p = _aligned_malloc(size, align))
+#else
+        if (void* p = std::aligned_alloc(align, size))
+#endif
+        {
+            return p;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr)
+        {
+            throw std::bad_alloc{};
+        }
+        handler();
+    }
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return ::operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    try
+    {
+        return ::operator new(size, alignment);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return ::operator new(size, alignment, std::nothrow);
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+void operator delete[](void* p, std::align_val_t alignment) noexcept
+{
+    ::operator delete(p, alignment);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t alignment) noexcept
+{
+    ::operator delete(p, alignment);
+}
+
+void operator delete[](void* p, std::size_t, std::align_val_t alignment) noexcept
+{
+    ::operator delete(p, alignment);
+}
+
+void operator delete(void* p, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    ::operator delete(p, alignment);
+}
+
+void operator delete[](void* p, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    ::operator delete(p, alignment);
+}
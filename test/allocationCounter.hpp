@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+
+namespace yaclap_test
+{
+
+    /// <summary>
+    /// Counts the heap allocations of the current thread through the global `operator new` while the counter exists.
+    /// Counters can be nested, each counting all allocations in its lifetime.
+    /// Requires linking `allocationCounter.cpp`, which replaces the global `operator new` and `operator delete` of the
+    /// executable.
+    /// </summary>
+    class AllocationCounter
+    {
+    public:
+        AllocationCounter() noexcept;
+        ~AllocationCounter();
+
+        AllocationCounter(const AllocationCounter&) = delete;
+        AllocationCounter& operator=(const AllocationCounter&) = delete;
+
+        inline size_t Allocations() const noexcept
+        {
+            return m_allocations;
+        }
+
+        inline size_t Bytes() const noexcept
+        {
+            return m_bytes;
+        }
+
+        inline void Reset() noexcept
+        {
+            m_allocations = 0;
+            m_bytes = 0;
+        }
+
+        /// <summary>
+        /// Records an allocation of `bytes` in all counters of the current thread
+        /// </summary>
+        static void Record(size_t bytes) noexcept;
+
+    private:
+        AllocationCounter* m_outer;
+        size_t m_allocations{0};
+        size_t m_bytes{0};
+    };
+
+} // namespace yaclap_test
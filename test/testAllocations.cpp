@@ -0,0 +1,133 @@
+#include "allocationCounter.hpp"
+#include "yaclap.hpp"
+
+#ifdef _WIN32
+#include <tchar.h>
+#else
+#define _TCHAR char
+#define _T(A) A
+#endif
+
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <sstream>
+#include <string>
+
+namespace yaclap_test
+{
+
+    namespace
+    {
+        /// <summary>
+        /// A fixed grammar with a command, options, switches, and arguments
+        /// </summary>
+        struct Grammar
+        {
+            yaclap::Parser<_TCHAR> parser{_T("yaclap.exe"), _T("desc.")};
+            yaclap::Option<_TCHAR> config{_T("--config"), _T("file"), _T("desc.")};
+            yaclap::Option<_TCHAR> level{_T("--level"), _T("n"), _T("desc.")};
+            yaclap::Switch<_TCHAR> verbose{_T("--verbose"), _T("desc.")};
+            yaclap::Command<_TCHAR> build{_T("build"), _T("desc.")};
+            yaclap::Option<_TCHAR> jobs{_T("--jobs"), _T("n"), _T("desc.")};
+            yaclap::Switch<_TCHAR> clean{_T("--clean"), _T("desc.")};
+            yaclap::Argument<_TCHAR> project{_T("project"), _T("desc.")};
+
+            Grammar()
+            {
+                verbose.AddAlias(_T("-v"));
+                jobs.AddAlias(_T("-j"));
+                build.Add(jobs).Add(clean).Add(project);
+                parser.Add(config).Add(level).Add(verbose).Add(build);
+            }
+        };
+
+        const _TCHAR* const sampleArgv[] = {_T("yaclap.exe"), _T("--config"), _T("a.ini"), _T("-v"), _T("--level=3"),
+                                            _T("build"),      _T("-j"),       _T("16"),    _T("--clean"), _T("app")};
+        constexpr int sampleArgc = sizeof(sampleArgv) / sizeof(_TCHAR*);
+    } // namespace
+
+    // The budgets are upper bounds of the allocations seen with the supported standard libraries. Raise them only
+    // for deliberate changes.
+
+    TEST(Allocations, Parse)
+    {
+        Grammar g;
+        AllocationCounter counter;
+        yaclap::Parser<_TCHAR>::Result res = g.parser.Parse(sampleArgc, sampleArgv);
+        EXPECT_TRUE(res.IsSuccess());
+        EXPECT_LE(counter.Allocations(), 24);
+        EXPECT_LE(counter.Bytes(), 4096);
+    }
+
+    TEST(Allocations, ResultQueries)
+    {
+        Grammar g;
+        yaclap::Parser<_TCHAR>::Result res = g.parser.Parse(sampleArgc, sampleArgv);
+
+        AllocationCounter counter;
+        EXPECT_TRUE(res.HasCommand(g.build));
+        EXPECT_EQ(std::basic_string_view<_TCHAR>{_T("a.ini")}, res.GetOptionValue(g.config));
+        EXPECT_EQ(1, res.GetOptionValues(g.jobs).size());
+        EXPECT_EQ(1, res.HasSwitch(g.verbose));
+        EXPECT_EQ(1, res.HasSwitch(g.clean));
+        EXPECT_TRUE(res.GetArgument(g.project));
+        EXPECT_EQ(0, counter.Allocations());
+
+        // the first conversion allocates the conversion cache of the Result, later ones use it
+        EXPECT_EQ(16, res.GetOptionValue(g.jobs).AsInteger());
+        EXPECT_LE(counter.Allocations(), 1);
+        counter.Reset();
+        EXPECT_EQ(3, res.GetOptionValue(g.level).AsInteger());
+        EXPECT_EQ(16, res.GetOptionValue(g.jobs).AsInteger());
+        EXPECT_EQ(0, counter.Allocations());
+    }
+
+    TEST(Allocations, WarmSessionParse)
+    {
+        Grammar g;
+        yaclap::Parser<_TCHAR>::Session session{g.parser};
+
+        // once the buffers of the session are warm, parsing, queries, and conversions do not allocate
+        size_t warmAllocations = 0;
+        for (int i = 0; i < 10; ++i)
+        {
+            AllocationCounter counter;
+            yaclap::Parser<_TCHAR>::Result& res = session.Parse(sampleArgc, sampleArgv);
+            const bool success = res.IsSuccess();
+            const std::optional<long long> jobs = res.GetOptionValue(g.jobs).AsInteger();
+            const size_t verbose = res.HasSwitch(g.verbose);
+            if (i > 0)
+            {
+                warmAllocations += counter.Allocations();
+            }
+            else
+            {
+                EXPECT_GT(counter.Allocations(), 0);
+            }
+            EXPECT_TRUE(success);
+            EXPECT_EQ(16, jobs);
+            EXPECT_EQ(1, verbose);
+        }
+        EXPECT_EQ(0, warmAllocations);
+    }
+
+    TEST(Allocations, PrintHelp)
+    {
+        Grammar g;
+        std::basic_ostringstream<_TCHAR> stream;
+
+        AllocationCounter counter;
+        g.parser.PrintHelp(stream);
+        EXPECT_LE(counter.Allocations(), 32);
+
+        // the rendered help is cached, so only the stream may allocate, which already has grown large enough
+        const std::basic_string<_TCHAR> first = stream.str();
+        stream.str(std::basic_string<_TCHAR>{});
+        counter.Reset();
+        g.parser.PrintHelp(stream);
+        EXPECT_EQ(0, counter.Allocations());
+        EXPECT_EQ(first, stream.str());
+    }
+
+} // namespace yaclap_test
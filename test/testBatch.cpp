@@ -0,0 +1,82 @@
+#include "yaclap.hpp"
+
+#ifdef _WIN32
+#include <tchar.h>
+#else
+#define _TCHAR char
+#define _T(A) A
+#endif
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+namespace yaclap_test
+{
+
+    TEST(Batch, ResultsInInputOrder)
+    {
+        using Parser = yaclap::Parser<_TCHAR>;
+        using Command = yaclap::Command<_TCHAR>;
+        using Option = yaclap::Option<_TCHAR>;
+        using Argument = yaclap::Argument<_TCHAR>;
+
+        Parser parser{_T("yaclap.exe"), _T("desc.")};
+        Argument arg{_T("a"), _T("desc.")};
+        Option opt{_T("-o"), _T("o"), _T("desc.")};
+        Command cmd{_T("cmd"), _T("desc.")};
+        cmd.Add(arg);
+        parser.Add(opt).Add(cmd);
+
+        constexpr size_t count = 1000;
+        std::vector<std::basic_string<_TCHAR>> values;
+        values.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            values.emplace_back();
+            for (char c : std::to_string(i))
+            {
+                values.back() += static_cast<_TCHAR>(c);
+            }
+        }
+
+        // Every third command line misses its required argument
+        std::vector<std::vector<const _TCHAR*>> argvs;
+        std::vector<Parser::CommandLine> lines;
+        argvs.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            argvs.push_back({_T("yaclap.exe"), _T("-o"), values[i].c_str(), _T("cmd")});
+            if (i % 3 != 0)
+            {
+                argvs.back().push_back(values[i].c_str());
+            }
+            lines.push_back({static_cast<int>(argvs.back().size()), argvs.back().data()});
+        }
+
+        for (unsigned int threads : {1u, 4u, 0u})
+        {
+            std::vector<Parser::Result> results = parser.ParseBatch(lines, true, threads);
+            ASSERT_EQ(count, results.size());
+            for (size_t i = 0; i < count; ++i)
+            {
+                const std::basic_string_view<_TCHAR> value{values[i]};
+                EXPECT_EQ(i % 3 != 0, results[i].IsSuccess());
+                EXPECT_TRUE(results[i].HasCommand(cmd));
+                EXPECT_EQ(value, results[i].GetOptionValue(opt));
+                if (i % 3 != 0)
+                {
+                    EXPECT_EQ(value, results[i].GetArgument(arg));
+                }
+                else
+                {
+                    EXPECT_FALSE(results[i].GetArgument(arg));
+                }
+            }
+        }
+
+        EXPECT_TRUE(parser.ParseBatch(nullptr, 0).empty());
+    }
+
+} // namespace yaclap_test
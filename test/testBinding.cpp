@@ -0,0 +1,86 @@
+#include "yaclap.hpp"
+
+#ifdef _WIN32
+#include <tchar.h>
+#else
+#define _TCHAR char
+#define _T(A) A
+#endif
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+namespace yaclap_test
+{
+
+    TEST(Binding, StoresValuesWhileParsing)
+    {
+        using Parser = yaclap::Parser<_TCHAR>;
+        using Argument = yaclap::Argument<_TCHAR>;
+        using Option = yaclap::Option<_TCHAR>;
+        using Switch = yaclap::Switch<_TCHAR>;
+
+        uint32_t count = 0;
+        double scale = 0.0;
+        std::basic_string<_TCHAR> input;
+        bool force = false;
+        int verbosity = 0;
+        std::vector<int> levels;
+
+        Option countOption{_T("--count"), _T("n"), _T("desc.")};
+        countOption.Bind(&count);
+        Option scaleOption{_T("--scale"), _T("s"), _T("desc.")};
+        scaleOption.Bind(&scale);
+        Option levelOption{_T("--level"), _T("l"), _T("desc.")};
+        levelOption.Bind<int>([&](int v) { levels.push_back(v); });
+        Argument inputArgument{_T("input"), _T("desc.")};
+        inputArgument.Bind(&input);
+        Switch forceSwitch{_T("--force"), _T("desc.")};
+        forceSwitch.Bind(&force);
+        Switch verboseSwitch{_T("-v"), _T("desc.")};
+        verboseSwitch.Bind(&verbosity);
+
+        Parser parser{_T("yaclap.exe"), _T("desc.")};
+        parser.Add(countOption).Add(scaleOption).Add(levelOption).Add(inputArgument);
+        parser.Add(forceSwitch).Add(verboseSwitch);
+
+        const _TCHAR* const argv[] = {_T("yaclap.exe"), _T("--count"), _T("42"), _T("-v"),      _T("file.txt"),
+                                      _T("--scale=0.25"), _T("--level"), _T("1"),  _T("--level"), _T("x3"),
+                                      _T("-v"),           _T("--force")};
+        Parser::Result res = parser.Parse(sizeof(argv) / sizeof(_TCHAR*), argv);
+
+        EXPECT_TRUE(res.IsSuccess());
+        EXPECT_EQ(42u, count);
+        EXPECT_EQ(0.25, scale);
+        EXPECT_EQ(std::basic_string<_TCHAR>{_T("file.txt")}, input);
+        EXPECT_TRUE(force);
+        EXPECT_EQ(2, verbosity);
+        EXPECT_EQ((std::vector<int>{1, 3}), levels);
+
+        // the values are still available from the Result
+        EXPECT_EQ(std::basic_string_view<_TCHAR>(_T("42")), res.GetOptionValue(countOption));
+        EXPECT_EQ(2, res.HasSwitch(verboseSwitch));
+    }
+
+    TEST(Binding, ConversionErrorsAreReported)
+    {
+        using Parser = yaclap::Parser<_TCHAR>;
+        using Option = yaclap::Option<_TCHAR>;
+
+        int8_t small = 7;
+        Option opt{_T("-o"), _T("o"), _T("desc.")};
+        opt.Bind(&small);
+        Parser parser{_T("yaclap.exe"), _T("desc.")};
+        parser.Add(opt);
+
+        const _TCHAR* const argv[] = {_T("yaclap.exe"), _T("-o"), _T("300")};
+        Parser::Result res = parser.Parse(sizeof(argv) / sizeof(_TCHAR*), argv);
+
+        EXPECT_FALSE(res.IsSuccess());
+        EXPECT_FALSE(res.GetError().empty());
+        EXPECT_EQ(7, small);
+    }
+
+} // namespace yaclap_test
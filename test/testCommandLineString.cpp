@@ -0,0 +1,82 @@
+#include "yaclap.hpp"
+
+#ifdef _WIN32
+#include <tchar.h>
+#else
+#define _TCHAR char
+#define _T(A) A
+#endif
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+namespace yaclap_test
+{
+
+    TEST(CommandLineString, Tokenize)
+    {
+        using Parser = yaclap::Parser<_TCHAR>;
+        using Option = yaclap::Option<_TCHAR>;
+        using Argument = yaclap::Argument<_TCHAR>;
+        using sv = std::basic_string_view<_TCHAR>;
+
+        Parser parser{_T("yaclap.exe"), _T("desc.")};
+        Option opt{_T("--option-with-a-long-name"), _T("o"), _T("desc.")};
+        Argument arg{_T("a"), _T("desc.")};
+        parser.Add(opt).Add(arg);
+        parser.SetErrorOnUnmatchedArguments(false);
+
+        const sv commandLine{_T("  yaclap.exe\t--option-with-a-long-name 'a value with spaces'  ")
+                             _T("C:\\a\\rather\\long\\windows\\path\\file.txt --option-with-a-long-name=x\\ y ")
+                             _T("--option-with-a-long-name \"quoted \\\"inner\\\" text\"\r\n")
+                             _T("--option-with-a-long-name ab\"cd ef\"gh\"\"  -- ''")};
+        Parser::Result res = parser.Parse(commandLine, true);
+
+        EXPECT_TRUE(res.IsSuccess()) << res.GetError();
+        auto values = res.GetOptionValues(opt);
+        ASSERT_EQ(4, values.size());
+        EXPECT_EQ(sv{_T("a value with spaces")}, values[0]);
+        EXPECT_EQ(sv{_T("x y")}, values[1]);
+        EXPECT_EQ(sv{_T("quoted \"inner\" text")}, values[2]);
+        EXPECT_EQ(sv{_T("abcd efgh")}, values[3]);
+        EXPECT_EQ(2, values[0].GetPosition());
+
+        // Arguments without quotes and escapes point into the command line
+        const auto path = res.GetArgument(arg);
+        EXPECT_EQ(sv{_T("C:\\a\\rather\\long\\windows\\path\\file.txt")}, path);
+        EXPECT_GE(path.data(), commandLine.data());
+        EXPECT_LT(path.data(), commandLine.data() + commandLine.size());
+
+        ASSERT_EQ(1, res.UnmatchedArguments().size());
+        EXPECT_EQ(sv{}, res.UnmatchedArguments()[0]);
+
+        res = parser.Parse(sv{_T("--option-with-a-long-name \"unterminated")});
+        EXPECT_FALSE(res.IsSuccess());
+
+        res = parser.Parse(sv{_T(" \t ")});
+        EXPECT_FALSE(res.GetArgument(arg));
+        EXPECT_EQ(0, res.UnmatchedArguments().size());
+    }
+
+    TEST(CommandLineString, SessionBufferReuse)
+    {
+        using Parser = yaclap::Parser<_TCHAR>;
+        using Option = yaclap::Option<_TCHAR>;
+        using sv = std::basic_string_view<_TCHAR>;
+
+        Parser parser{_T("yaclap.exe"), _T("desc.")};
+        Option opt{_T("-o"), _T("o"), _T("desc.")};
+        parser.Add(opt);
+
+        Parser::Session session{parser};
+        Parser::Result copy = session.Parse(sv{_T("-o \"first value\"")});
+        EXPECT_EQ(sv{_T("first value")}, copy.GetOptionValue(opt));
+
+        // The copy keeps its buffer, while the session parses into a new one
+        Parser::Result& res = session.Parse(sv{_T("-o \"other value\"")});
+        EXPECT_EQ(sv{_T("other value")}, res.GetOptionValue(opt));
+        EXPECT_EQ(sv{_T("first value")}, copy.GetOptionValue(opt));
+    }
+
+} // namespace yaclap_test
@@ -0,0 +1,160 @@
+#include "yaclap.hpp"
+
+#ifdef _WIN32
+#include <tchar.h>
+#else
+#define _TCHAR char
+#define _T(A) A
+#endif
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace yaclap_test
+{
+
+    namespace
+    {
+        using sv = std::basic_string_view<_TCHAR>;
+
+        std::vector<sv> Sorted(std::pmr::vector<sv> const& candidates)
+        {
+            std::vector<sv> v{candidates.begin(), candidates.end()};
+            std::sort(v.begin(), v.end());
+            return v;
+        }
+    } // namespace
+
+    TEST(Completion, Candidates)
+    {
+        using Parser = yaclap::Parser<_TCHAR>;
+        using StringCompare = yaclap::Alias<_TCHAR>::StringCompare;
+        using Command = yaclap::Command<_TCHAR>;
+        using Option = yaclap::Option<_TCHAR>;
+        using Switch = yaclap::Switch<_TCHAR>;
+        using Argument = yaclap::Argument<_TCHAR>;
+
+        Parser parser{_T("yaclap.exe"), _T("desc.")};
+        Switch verbose{_T("--verbose"), _T("desc.")};
+        Switch hidden{_T("--version-internal"), _T("desc.")};
+        hidden.HideFromHelp();
+        Option target{{_T("--Target"), StringCompare::CaseInsensitive}, _T("t"), _T("desc.")};
+        Argument project{_T("project"), _T("desc.")};
+        Command build{_T("build"), _T("desc.")};
+        build.AddAlias(_T("b"));
+        build.Add(target).Add(project);
+        Command bench{_T("bench"), _T("desc.")};
+        parser.Add(verbose).Add(hidden).Add(build).Add(bench);
+        parser.EnableImplicitHelpSwitch(false);
+
+        Parser::Completion completion{parser};
+
+        const _TCHAR* const argv1[] = {_T("yaclap.exe"), _T("b")};
+        EXPECT_EQ((std::vector<sv>{_T("b"), _T("bench"), _T("build")}), Sorted(completion.Complete(2, argv1, 1)));
+        EXPECT_EQ(nullptr, completion.GetCommand());
+
+        const _TCHAR* const argv2[] = {_T("yaclap.exe"), _T("build"), _T("--")};
+        EXPECT_EQ((std::vector<sv>{_T("--Target"), _T("--verbose")}), Sorted(completion.Complete(3, argv2, 2)));
+        EXPECT_EQ(&*parser.CommandsBegin(), completion.GetCommand());
+        ASSERT_NE(nullptr, completion.GetPendingArgument());
+        EXPECT_EQ(sv{_T("project")}, completion.GetPendingArgument()->GetName());
+
+        // Case-insensitive names complete case-insensitively
+        const _TCHAR* const argv3[] = {_T("yaclap.exe"), _T("build"), _T("--t")};
+        EXPECT_EQ((std::vector<sv>{_T("--Target")}), Sorted(completion.Complete(3, argv3, 2)));
+
+        // Option values are not completed with names
+        const _TCHAR* const argv4[] = {_T("yaclap.exe"), _T("build"), _T("--target"), _T("")};
+        EXPECT_TRUE(completion.Complete(4, argv4, 3).empty());
+        ASSERT_NE(nullptr, completion.GetPendingOption());
+        EXPECT_EQ(nullptr, completion.GetPendingArgument());
+
+        // Cursor at the end of the command line completes a new empty argument
+        const _TCHAR* const argv5[] = {_T("yaclap.exe"), _T("build"), _T("--target"), _T("x")};
+        EXPECT_EQ(2, completion.Complete(4, argv5, 4).size());
+
+        // A changed prefix is parsed again
+        const _TCHAR* const argv6[] = {_T("yaclap.exe"), _T("bench"), _T("--")};
+        EXPECT_EQ((std::vector<sv>{_T("--verbose")}), Sorted(completion.Complete(3, argv6, 2)));
+
+        const _TCHAR* const argv7[] = {_T("yaclap.exe"), _T("--"), _T("")};
+        EXPECT_TRUE(completion.Complete(3, argv7, 2).empty());
+    }
+
+    TEST(Completion, Scripts)
+    {
+        using Parser = yaclap::Parser<_TCHAR>;
+        using Command = yaclap::Command<_TCHAR>;
+        using Option = yaclap::Option<_TCHAR>;
+        using Switch = yaclap::Switch<_TCHAR>;
+        using string = std::basic_string<_TCHAR>;
+
+        Parser parser{_T("my-tool"), _T("desc.")};
+        Switch verbose{_T("--verbose"), _T("desc.")};
+        Switch hidden{_T("--secret"), _T("desc.")};
+        hidden.HideFromHelp();
+        Option target{_T("--target"), _T("t"), _T("desc.")};
+        target.AddAlias(_T("-t"));
+        Command build{_T("build"), _T("desc.")};
+        build.Add(target);
+        parser.Add(verbose).Add(hidden).Add(build);
+        parser.EnableImplicitHelpSwitch(false);
+
+        std::basic_ostringstream<_TCHAR> bash;
+        parser.PrintCompletionScript(Parser::Shell::Bash, bash);
+        const string b = bash.str();
+        EXPECT_NE(string::npos, b.find(_T("complete -o default -F _yaclap_my_tool my-tool")));
+        EXPECT_NE(string::npos, b.find(_T("'0:build') state=1 ;;")));
+        EXPECT_NE(string::npos, b.find(_T("'1:--target'|'1:-t') ((i++)) ;;")));
+        EXPECT_NE(string::npos, b.find(_T("0) words='build --verbose' ;;")));
+        EXPECT_NE(string::npos, b.find(_T("1) words='--verbose --target -t' ;;")));
+        EXPECT_EQ(string::npos, b.find(_T("--secret")));
+
+        std::basic_ostringstream<_TCHAR> zsh;
+        parser.PrintCompletionScript(Parser::Shell::Zsh, zsh);
+        const string z = zsh.str();
+        EXPECT_EQ(0, z.find(_T("#compdef my-tool\n")));
+        EXPECT_NE(string::npos, z.find(_T("0) compadd -- 'build' '--verbose' && return ;;")));
+        EXPECT_NE(string::npos, z.find(_T("_files")));
+        EXPECT_EQ(string::npos, z.find(_T("--secret")));
+
+        std::basic_ostringstream<_TCHAR> fish;
+        parser.PrintCompletionScript(Parser::Shell::Fish, fish);
+        const string f = fish.str();
+        EXPECT_NE(string::npos, f.find(_T("-n 'test (__yaclap_my_tool_state) = 1' -a '--verbose --target -t'")));
+        EXPECT_NE(string::npos, f.find(_T("-n 'contains (__yaclap_my_tool_state) value stop' -F")));
+        EXPECT_EQ(string::npos, f.find(_T("--secret")));
+    }
+
+    TEST(Completion, ScriptsQuoteProgramName)
+    {
+        using Parser = yaclap::Parser<_TCHAR>;
+        using Switch = yaclap::Switch<_TCHAR>;
+        using string = std::basic_string<_TCHAR>;
+
+        Parser parser{_T("my tool's;x"), _T("desc.")};
+        Switch verbose{_T("--verbose"), _T("desc.")};
+        parser.Add(verbose);
+
+        std::basic_ostringstream<_TCHAR> bash;
+        parser.PrintCompletionScript(Parser::Shell::Bash, bash);
+        const string b = bash.str();
+        EXPECT_NE(string::npos, b.find(_T("complete -o default -F _yaclap_my_tool_s_x 'my tool'\\''s;x'\n")));
+
+        std::basic_ostringstream<_TCHAR> zsh;
+        parser.PrintCompletionScript(Parser::Shell::Zsh, zsh);
+        const string z = zsh.str();
+        EXPECT_EQ(string::npos, z.find(_T("#compdef")));
+        EXPECT_NE(string::npos, z.find(_T("compdef _yaclap_my_tool_s_x 'my tool'\\''s;x'\n")));
+
+        std::basic_ostringstream<_TCHAR> fish;
+        parser.PrintCompletionScript(Parser::Shell::Fish, fish);
+        const string f = fish.str();
+        EXPECT_NE(string::npos, f.find(_T("complete -c 'my tool\\'s;x' -f\n")));
+        EXPECT_EQ(string::npos, f.find(_T("complete -c my")));
+    }
+
+} // namespace yaclap_test
@@ -0,0 +1,232 @@
+#include "yaclap.hpp"
+
+#ifdef _WIN32
+#include <tchar.h>
+#else
+#define _TCHAR char
+#define _T(A) A
+#endif
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+namespace yaclap_test
+{
+
+    TEST(ConfigFile, Syntax)
+    {
+        using ConfigFile = yaclap::ConfigFile<_TCHAR>;
+        using sv = std::basic_string_view<_TCHAR>;
+
+        const sv text{_T("# comment\n")
+                      _T("level = 3\r\n")
+                      _T("  ; comment\n")
+                      _T("name = \" quoted \"\n")
+                      _T("force\n")
+                      _T("Level=4\n")
+                      _T("[ build ]\n")
+                      _T("level=5")};
+        ConfigFile config{text};
+
+        ASSERT_EQ(5, config.Entries().size());
+        ConfigFile::Entry const* e = config.FindFirst(ConfigFile::rootSection, _T("LEVEL"));
+        ASSERT_NE(nullptr, e);
+        EXPECT_EQ(sv{_T("3")}, e->value);
+        EXPECT_EQ(2, e->line);
+        e = config.Next(*e);
+        ASSERT_NE(nullptr, e);
+        EXPECT_EQ(sv{_T("Level")}, e->key);
+        EXPECT_EQ(sv{_T("4")}, e->value);
+        EXPECT_EQ(nullptr, config.Next(*e));
+
+        EXPECT_EQ(sv{_T(" quoted ")}, config.FindFirst(ConfigFile::rootSection, _T("name"))->value);
+        EXPECT_TRUE(config.FindFirst(ConfigFile::rootSection, _T("force"))->value.empty());
+        EXPECT_EQ(text.data() + text.size() - 1, config.Entries().back().value.data());
+
+        EXPECT_EQ(sv{_T("level")}, ConfigFile::KeyOf(_T("--level")));
+        EXPECT_EQ(sv{_T("l")}, ConfigFile::KeyOf(_T("/l")));
+    }
+
+    TEST(ConfigFile, ValuesBelowCommandLine)
+    {
+        using Parser = yaclap::Parser<_TCHAR>;
+        using Command = yaclap::Command<_TCHAR>;
+        using Option = yaclap::Option<_TCHAR>;
+        using Switch = yaclap::Switch<_TCHAR>;
+        using ConfigFile = yaclap::ConfigFile<_TCHAR>;
+        using Origin = Parser::ValueOrigin;
+        using sv = std::basic_string_view<_TCHAR>;
+
+        const _TCHAR* systemText = _T("level = 1\n")
+                                   _T("name = system\n")
+                                   _T("[build]\n")
+                                   _T("jobs = 2\n");
+        const _TCHAR* userText = _T("name = user\n")
+                                 _T("name = again\n")
+                                 _T("verbose\n")
+                                 _T("quiet = false\n")
+                                 _T("[BUILD]\n")
+                                 _T("jobs = 8\n")
+                                 _T("release = yes\n");
+
+        int level = 0;
+        Option levelOption{_T("--level"), _T("n"), _T("desc.")};
+        levelOption.Bind(&level);
+        Option nameOption{_T("--name"), _T("s"), _T("desc.")};
+        Switch verboseSwitch{_T("-v"), _T("desc.")};
+        verboseSwitch.AddAlias(_T("--verbose"));
+        Switch quietSwitch{_T("--quiet"), _T("desc.")};
+        Option jobsOption{_T("--jobs"), _T("n"), _T("desc.")};
+        Switch releaseSwitch{_T("--release"), _T("desc.")};
+        Command build{{_T("build"), yaclap::Alias<_TCHAR>::StringCompare::CaseInsensitive}, _T("desc.")};
+        build.Add(jobsOption).Add(releaseSwitch);
+
+        Parser parser{_T("yaclap.exe"), _T("desc.")};
+        parser.Add(levelOption).Add(nameOption).Add(verboseSwitch).Add(quietSwitch).Add(build);
+        parser.AddConfigFile(std::make_shared<const ConfigFile>(systemText));
+        parser.AddConfigFile(std::make_shared<const ConfigFile>(userText));
+
+        const _TCHAR* const argv[] = {_T("yaclap.exe"), _T("--level"), _T("7"), _T("build")};
+        Parser::Result res = parser.Parse(sizeof(argv) / sizeof(_TCHAR*), argv);
+
+        EXPECT_TRUE(res.IsSuccess());
+        EXPECT_EQ(7, level);
+        EXPECT_EQ(Origin::CommandLine, res.GetOptionValue(levelOption).GetOrigin());
+
+        // all values are taken from the file with the highest precedence
+        auto names = res.GetOptionValues(nameOption);
+        ASSERT_EQ(2, names.size());
+        EXPECT_EQ(sv{_T("user")}, names[0]);
+        EXPECT_EQ(sv{_T("again")}, names[1]);
+        EXPECT_EQ(Origin::ConfigFile, names[0].GetOrigin());
+        EXPECT_EQ(1, names[0].GetPosition());
+
+        EXPECT_EQ(1, res.HasSwitch(verboseSwitch));
+        EXPECT_EQ(0, res.HasSwitch(quietSwitch));
+        EXPECT_EQ(sv{_T("8")}, res.GetOptionValue(jobsOption));
+        EXPECT_EQ(1, res.HasSwitch(releaseSwitch));
+
+        // without the command, its section is not used
+        res = parser.Parse(2, argv);
+        EXPECT_FALSE(res.GetOptionValue(jobsOption));
+
+        // conversion errors report the line
+        const _TCHAR* const argv2[] = {_T("yaclap.exe"), _T("--name"), _T("x")};
+        parser.ClearConfigFiles();
+        parser.AddConfigFile(std::make_shared<const ConfigFile>(_T("\n\nlevel = high\n")));
+        res = parser.Parse(sizeof(argv2) / sizeof(_TCHAR*), argv2);
+        EXPECT_FALSE(res.IsSuccess());
+        EXPECT_NE(std::basic_string<_TCHAR>::npos, res.GetError().find(_T("line 3")));
+    }
+
+    TEST(ConfigFile, NestedCommandSections)
+    {
+        using Parser = yaclap::Parser<_TCHAR>;
+        using Command = yaclap::Command<_TCHAR>;
+        using Option = yaclap::Option<_TCHAR>;
+        using ConfigFile = yaclap::ConfigFile<_TCHAR>;
+        using sv = std::basic_string_view<_TCHAR>;
+
+        const _TCHAR* text = _T("[add]\n")
+                             _T("name = top\n")
+                             _T("[remote.add]\n")
+                             _T("name = remote\n")
+                             _T("[ tag . add ]\n")
+                             _T("name = tag\n");
+
+        Option remoteName{_T("--name"), _T("s"), _T("desc.")};
+        Command remoteAdd{_T("add"), _T("desc.")};
+        remoteAdd.Add(remoteName);
+        Command remote{_T("remote"), _T("desc.")};
+        remote.Add(remoteAdd);
+
+        Option tagName{_T("--name"), _T("s"), _T("desc.")};
+        Command tagAdd{_T("add"), _T("desc.")};
+        tagAdd.Add(tagName);
+        Command tag{_T("tag"), _T("desc.")};
+        tag.Add(tagAdd);
+
+        Option addName{_T("--name"), _T("s"), _T("desc.")};
+        Command add{_T("add"), _T("desc.")};
+        add.Add(addName);
+
+        Parser parser{_T("yaclap.exe"), _T("desc.")};
+        parser.Add(remote).Add(tag).Add(add);
+        parser.AddConfigFile(std::make_shared<const ConfigFile>(text));
+
+        const _TCHAR* const argv1[] = {_T("yaclap.exe"), _T("remote"), _T("add")};
+        Parser::Result res = parser.Parse(sizeof(argv1) / sizeof(_TCHAR*), argv1);
+        EXPECT_TRUE(res.IsSuccess());
+        EXPECT_EQ(sv{_T("remote")}, res.GetOptionValue(remoteName));
+
+        const _TCHAR* const argv2[] = {_T("yaclap.exe"), _T("tag"), _T("add")};
+        res = parser.Parse(sizeof(argv2) / sizeof(_TCHAR*), argv2);
+        EXPECT_TRUE(res.IsSuccess());
+        EXPECT_EQ(sv{_T("tag")}, res.GetOptionValue(tagName));
+
+        const _TCHAR* const argv3[] = {_T("yaclap.exe"), _T("add")};
+        res = parser.Parse(sizeof(argv3) / sizeof(_TCHAR*), argv3);
+        EXPECT_TRUE(res.IsSuccess());
+        EXPECT_EQ(sv{_T("top")}, res.GetOptionValue(addName));
+
+        // a section of a nested command does not apply to its parent
+        const _TCHAR* const argv4[] = {_T("yaclap.exe"), _T("remote")};
+        res = parser.Parse(sizeof(argv4) / sizeof(_TCHAR*), argv4);
+        EXPECT_TRUE(res.IsSuccess());
+        EXPECT_FALSE(res.GetOptionValue(remoteName));
+    }
+
+    TEST(ConfigFile, MappedFile)
+    {
+        using Parser = yaclap::Parser<_TCHAR>;
+        using Option = yaclap::Option<_TCHAR>;
+        using ConfigFile = yaclap::ConfigFile<_TCHAR>;
+
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / "yaclap_test_config.ini";
+        std::ofstream{path, std::ios::binary} << "\xEF\xBB\xBF" << "# test\nscale = 0.5\n";
+
+        Option scaleOption{_T("--scale"), _T("f"), _T("desc.")};
+        Parser parser{_T("yaclap.exe"), _T("desc.")};
+        parser.Add(scaleOption);
+        EXPECT_EQ(nullptr, ConfigFile::Open(path.parent_path() / "yaclap_test_missing.ini"));
+        parser.AddConfigFile(ConfigFile::Open(path));
+
+        const _TCHAR* const argv[] = {_T("yaclap.exe")};
+        Parser::Result res = parser.Parse(sizeof(argv) / sizeof(_TCHAR*), argv);
+        // the Result keeps the mapped file alive
+        parser.ClearConfigFiles();
+
+        EXPECT_TRUE(res.IsSuccess());
+        EXPECT_EQ(0.5, res.GetOptionValue(scaleOption).AsDouble());
+
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+
+    TEST(ConfigFile, MissingFileIsIgnored)
+    {
+        using Parser = yaclap::Parser<_TCHAR>;
+        using Option = yaclap::Option<_TCHAR>;
+        using ConfigFile = yaclap::ConfigFile<_TCHAR>;
+
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / "yaclap_test_missing.ini";
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+
+        Option scaleOption{_T("--scale"), _T("f"), _T("desc.")};
+        Parser parser{_T("yaclap.exe"), _T("desc.")};
+        parser.Add(scaleOption);
+        EXPECT_NO_THROW(parser.AddConfigFile(ConfigFile::Open(path)));
+        EXPECT_TRUE(parser.ConfigFiles().empty());
+
+        const _TCHAR* const argv[] = {_T("yaclap.exe")};
+        Parser::Result res = parser.Parse(sizeof(argv) / sizeof(_TCHAR*), argv);
+        EXPECT_TRUE(res.IsSuccess());
+        EXPECT_FALSE(res.GetOptionValue(scaleOption));
+    }
+
+} // namespace yaclap_test
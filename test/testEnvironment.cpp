@@ -0,0 +1,111 @@
+#include "yaclap.hpp"
+
+#ifdef _WIN32
+#include <tchar.h>
+#else
+#define _TCHAR char
+#define _T(A) A
+#endif
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+namespace yaclap_test
+{
+
+    TEST(Environment, Snapshot)
+    {
+        using Environment = yaclap::Environment<_TCHAR>;
+        using sv = std::basic_string_view<_TCHAR>;
+
+        const _TCHAR* const entries[] = {_T("A=1"), _T("EMPTY="), _T("NOVALUE"), _T("B=x=y"), _T("A=2")};
+        Environment env{std::begin(entries), std::end(entries)};
+
+        EXPECT_EQ(3, env.Size());
+        EXPECT_EQ(sv{_T("1")}, env.Find(_T("A")).value());
+        EXPECT_EQ(sv{_T("")}, env.Find(_T("EMPTY")).value());
+        EXPECT_EQ(sv{_T("x=y")}, env.Find(_T("B")).value());
+        EXPECT_FALSE(env.Find(_T("NOVALUE")).has_value());
+        EXPECT_EQ(sv{_T("B")}, Environment::NameOf(env.Find(_T("B")).value()));
+
+        // the process environment is captured once
+        EXPECT_EQ(Environment::Process().get(), Environment::Process().get());
+    }
+
+    TEST(Environment, FallbackBelowCommandLine)
+    {
+        using Parser = yaclap::Parser<_TCHAR>;
+        using Option = yaclap::Option<_TCHAR>;
+        using Switch = yaclap::Switch<_TCHAR>;
+        using Origin = Parser::ValueOrigin;
+        using sv = std::basic_string_view<_TCHAR>;
+
+        const _TCHAR* const entries[] = {_T("APP_LEVEL=3"), _T("APP_NAME=env"), _T("APP_FORCE=true"),
+                                         _T("APP_QUIET=0")};
+        auto env = std::make_shared<const yaclap::Environment<_TCHAR>>(std::begin(entries), std::end(entries));
+
+        int level = 0;
+        Option levelOption{_T("--level"), _T("n"), _T("desc.")};
+        levelOption.FromEnvironment(_T("APP_LEVEL")).Bind(&level);
+        Option nameOption{_T("--name"), _T("s"), _T("desc.")};
+        nameOption.FromEnvironment(_T("APP_NAME"));
+        Option unsetOption{_T("--unset"), _T("s"), _T("desc.")};
+        unsetOption.FromEnvironment(_T("APP_UNSET"));
+        Switch forceSwitch{_T("--force"), _T("desc.")};
+        forceSwitch.FromEnvironment(_T("APP_FORCE"));
+        Switch quietSwitch{_T("--quiet"), _T("desc.")};
+        quietSwitch.FromEnvironment(_T("APP_QUIET"));
+
+        Parser parser{_T("yaclap.exe"), _T("desc.")};
+        parser.Add(levelOption).Add(nameOption).Add(unsetOption).Add(forceSwitch).Add(quietSwitch);
+        parser.SetEnvironment(env);
+
+        const _TCHAR* const argv[] = {_T("yaclap.exe"), _T("--name"), _T("cmd")};
+        Parser::Result res = parser.Parse(sizeof(argv) / sizeof(_TCHAR*), argv);
+        env.reset();
+
+        EXPECT_TRUE(res.IsSuccess());
+        EXPECT_EQ(3, level);
+
+        auto levelValue = res.GetOptionValue(levelOption);
+        EXPECT_EQ(sv{_T("3")}, levelValue);
+        EXPECT_EQ(Origin::Environment, levelValue.GetOrigin());
+        EXPECT_EQ(-1, levelValue.GetPosition());
+
+        auto nameValue = res.GetOptionValue(nameOption);
+        EXPECT_EQ(sv{_T("cmd")}, nameValue);
+        EXPECT_EQ(Origin::CommandLine, nameValue.GetOrigin());
+        EXPECT_EQ(1, res.GetOptionCount(nameOption));
+
+        EXPECT_FALSE(res.GetOptionValue(unsetOption));
+        EXPECT_EQ(Origin::None, res.GetOptionValue(unsetOption).GetOrigin());
+
+        EXPECT_EQ(1, res.HasSwitch(forceSwitch));
+        EXPECT_EQ(0, res.HasSwitch(quietSwitch));
+    }
+
+    TEST(Environment, ConversionErrorsNameTheVariable)
+    {
+        using Parser = yaclap::Parser<_TCHAR>;
+        using Option = yaclap::Option<_TCHAR>;
+
+        const _TCHAR* const entries[] = {_T("APP_COUNT=12x")};
+        Option countOption{_T("--count"), _T("n"), _T("desc.")};
+        countOption.FromEnvironment(_T("APP_COUNT"));
+        Parser parser{_T("yaclap.exe"), _T("desc.")};
+        parser.Add(countOption);
+        parser.SetEnvironment(
+            std::make_shared<const yaclap::Environment<_TCHAR>>(std::begin(entries), std::end(entries)));
+
+        const _TCHAR* const argv[] = {_T("yaclap.exe")};
+        Parser::Result res = parser.Parse(sizeof(argv) / sizeof(_TCHAR*), argv);
+        EXPECT_TRUE(res.IsSuccess());
+
+        EXPECT_FALSE(res.GetOptionValue(countOption).AsInteger().has_value());
+        EXPECT_FALSE(res.IsSuccess());
+        EXPECT_NE(std::basic_string<_TCHAR>::npos, res.GetError().find(_T("APP_COUNT")));
+    }
+
+} // namespace yaclap_test
@@ -0,0 +1,78 @@
+#include "yaclap.hpp"
+
+#ifdef _WIN32
+#include <tchar.h>
+#else
+#define _TCHAR char
+#define _T(A) A
+#endif
+
+#include <gtest/gtest.h>
+
+namespace yaclap_test
+{
+
+    TEST(GrammarSharing, SubtreesAreShared)
+    {
+        using Parser = yaclap::Parser<_TCHAR>;
+        using Command = yaclap::Command<_TCHAR>;
+        using Option = yaclap::Option<_TCHAR>;
+
+        Option opt{_T("-o"), _T("o"), _T("desc.")};
+        Command shared{_T("shared"), _T("desc.")};
+        shared.Add(opt);
+
+        Command first{_T("first"), _T("desc.")};
+        Command second{_T("second"), _T("desc.")};
+        first.Add(shared);
+        second.Add(shared);
+        Parser parser{_T("yaclap.exe"), _T("desc.")};
+        parser.Add(first).Add(second);
+
+        // Both parents reference the same contents of the shared command, down to the option
+        Command const& inFirst = *parser.CommandsBegin()->CommandsBegin();
+        Command const& inSecond = *(parser.CommandsBegin() + 1)->CommandsBegin();
+        EXPECT_EQ(&*inFirst.OptionsBegin(), &*inSecond.OptionsBegin());
+        EXPECT_EQ(&*shared.OptionsBegin(), &*inFirst.OptionsBegin());
+
+        const _TCHAR* const argv1[] = {_T("yaclap.exe"), _T("first"), _T("shared"), _T("-o"), _T("1")};
+        Parser::Result res = parser.Parse(sizeof(argv1) / sizeof(_TCHAR*), argv1);
+        EXPECT_TRUE(res.IsSuccess());
+        EXPECT_TRUE(res.HasCommand(first));
+        EXPECT_TRUE(res.HasCommand(shared));
+        EXPECT_EQ(std::basic_string_view<_TCHAR>(_T("1")), res.GetOptionValue(opt));
+
+        const _TCHAR* const argv2[] = {_T("yaclap.exe"), _T("second"), _T("shared"), _T("-o"), _T("2")};
+        res = parser.Parse(sizeof(argv2) / sizeof(_TCHAR*), argv2);
+        EXPECT_TRUE(res.IsSuccess());
+        EXPECT_TRUE(res.HasCommand(second));
+        EXPECT_EQ(std::basic_string_view<_TCHAR>(_T("2")), res.GetOptionValue(opt));
+    }
+
+    TEST(GrammarSharing, ChangesDoNotAffectCopies)
+    {
+        using Parser = yaclap::Parser<_TCHAR>;
+        using Command = yaclap::Command<_TCHAR>;
+        using Switch = yaclap::Switch<_TCHAR>;
+
+        Switch a{_T("-a"), _T("desc.")};
+        Switch b{_T("-b"), _T("desc.")};
+        Command cmd{_T("cmd"), _T("desc.")};
+        cmd.Add(a);
+        Parser parser{_T("yaclap.exe"), _T("desc.")};
+        parser.Add(cmd);
+
+        // Adding to the original after it was added to the parser leaves the parser's copy unchanged
+        cmd.Add(b);
+        EXPECT_EQ(2, cmd.SwitchesEnd() - cmd.SwitchesBegin());
+        Command const& added = *parser.CommandsBegin();
+        EXPECT_EQ(1, added.SwitchesEnd() - added.SwitchesBegin());
+
+        const _TCHAR* const argv[] = {_T("yaclap.exe"), _T("cmd"), _T("-a"), _T("-b")};
+        Parser::Result res = parser.Parse(sizeof(argv) / sizeof(_TCHAR*), argv);
+        EXPECT_FALSE(res.IsSuccess());
+        EXPECT_EQ(1, res.HasSwitch(a));
+        EXPECT_EQ(0, res.HasSwitch(b));
+    }
+
+} // namespace yaclap_test
@@ -0,0 +1,100 @@
+#include "yaclap.hpp"
+
+#ifdef _WIN32
+#include <tchar.h>
+#else
+#define _TCHAR char
+#define _T(A) A
+#endif
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace yaclap_test
+{
+
+    TEST(HelpCache, InvalidatedByGrammarChanges)
+    {
+        using Parser = yaclap::Parser<_TCHAR>;
+        using Command = yaclap::Command<_TCHAR>;
+        using Switch = yaclap::Switch<_TCHAR>;
+        using string = std::basic_string<_TCHAR>;
+
+        auto help = [](Parser const& parser, Command const* cmd)
+        {
+            std::basic_ostringstream<_TCHAR> stream;
+            if (cmd != nullptr)
+            {
+                parser.PrintHelp(*cmd, stream);
+            }
+            else
+            {
+                parser.PrintHelp(stream);
+            }
+            return stream.str();
+        };
+
+        Parser parser{_T("yaclap.exe"), _T("desc.")};
+        Command cmd{_T("cmd"), _T("Command description")};
+        parser.Add(cmd);
+        Command const* parserCmd = &*parser.CommandsBegin();
+
+        const string root1 = help(parser, nullptr);
+        const string cmd1 = help(parser, parserCmd);
+        EXPECT_NE(root1, cmd1);
+        EXPECT_EQ(root1, help(parser, nullptr));
+        EXPECT_EQ(cmd1, help(parser, parserCmd));
+        EXPECT_NE(string::npos, root1.find(_T("--help")));
+
+        parser.Add(Switch{_T("--verbose"), _T("desc.")});
+        const string root2 = help(parser, nullptr);
+        EXPECT_NE(string::npos, root2.find(_T("--verbose")));
+
+        parser.EnableImplicitHelpSwitch(false);
+        EXPECT_EQ(string::npos, help(parser, nullptr).find(_T("--help")));
+
+        // A copy starts with an empty cache, and renders the same text
+        Parser copy{parser};
+        EXPECT_EQ(help(parser, nullptr), help(copy, nullptr));
+    }
+
+    TEST(HelpCache, ConcurrentPrint)
+    {
+        using Parser = yaclap::Parser<_TCHAR>;
+        using Switch = yaclap::Switch<_TCHAR>;
+        using string = std::basic_string<_TCHAR>;
+
+        Parser parser{_T("yaclap.exe"), _T("desc.")};
+        parser.Add(Switch{_T("--verbose"), _T("desc.")});
+
+        std::vector<string> texts(8);
+        std::vector<std::thread> threads;
+        for (string& text : texts)
+        {
+            threads.emplace_back(
+                [&parser, &text]()
+                {
+                    for (int i = 0; i < 50; ++i)
+                    {
+                        std::basic_ostringstream<_TCHAR> stream;
+                        parser.PrintHelp(stream);
+                        text = stream.str();
+                    }
+                });
+        }
+        for (std::thread& t : threads)
+        {
+            t.join();
+        }
+        for (string const& text : texts)
+        {
+            EXPECT_EQ(texts[0], text);
+        }
+        EXPECT_NE(string::npos, texts[0].find(_T("--verbose")));
+    }
+
+} // namespace yaclap_test
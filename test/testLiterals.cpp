@@ -0,0 +1,103 @@
+#include "yaclap.hpp"
+
+#ifdef _WIN32
+#include <tchar.h>
+#else
+#define _TCHAR char
+#define _T(A) A
+#endif
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <utility>
+
+namespace yaclap_test
+{
+
+    namespace
+    {
+        const _TCHAR inputName[] = _T("--Input");
+        const _TCHAR inputArgName[] = _T("file");
+        const _TCHAR inputDescription[] = _T("The input file");
+        const _TCHAR verboseName[] = _T("-v");
+    } // namespace
+
+    TEST(Literals, NamesReferenceLiterals)
+    {
+        using Parser = yaclap::Parser<_TCHAR>;
+        using Literal = yaclap::Literal<_TCHAR>;
+        using Option = yaclap::Option<_TCHAR>;
+        using Switch = yaclap::Switch<_TCHAR>;
+        using StringCompare = yaclap::Alias<_TCHAR>::StringCompare;
+
+        Option input{{Literal{inputName}, StringCompare::CaseInsensitive}, Literal{inputArgName},
+                     Literal{inputDescription}};
+        Switch verbose{Literal{verboseName}, Literal{inputDescription}};
+
+        EXPECT_EQ(inputName, input.NameAliasBegin()->GetNameView().data());
+        EXPECT_EQ(inputArgName, input.GetArgumentNameView().data());
+        EXPECT_EQ(inputDescription, input.GetDescriptionView().data());
+
+        // copies, e.g. when added to a parser, still reference the literals
+        Parser parser{Literal{_T("yaclap.exe")}, Literal{_T("desc.")}};
+        parser.Add(input).Add(verbose);
+        EXPECT_EQ(inputName, parser.OptionsBegin()->NameAliasBegin()->GetNameView().data());
+        EXPECT_EQ(verboseName, parser.SwitchesBegin()->NameAliasBegin()->GetNameView().data());
+
+        const _TCHAR* const argv[] = {_T("yaclap.exe"), _T("--INPUT"), _T("a.txt"), _T("-v")};
+        Parser::Result res = parser.Parse(sizeof(argv) / sizeof(_TCHAR*), argv);
+
+        EXPECT_TRUE(res.IsSuccess());
+        EXPECT_EQ(std::basic_string_view<_TCHAR>(_T("a.txt")), res.GetOptionValue(input));
+        EXPECT_EQ(1, res.HasSwitch(verbose));
+
+        // the string getters copy the literal on first use, and keep the views referencing it
+        const std::basic_string<_TCHAR>& description = input.GetDescription();
+        EXPECT_EQ(std::basic_string<_TCHAR>{inputDescription}, description);
+        EXPECT_EQ(&description, &input.GetDescription());
+        EXPECT_EQ(std::basic_string<_TCHAR>{inputName} + _T("x"), input.NameAliasBegin()->GetName() + _T("x"));
+        std::basic_string<_TCHAR> argName = input.GetArgumentName();
+        EXPECT_EQ(std::basic_string<_TCHAR>{inputArgName}, argName);
+        EXPECT_EQ(inputDescription, input.GetDescriptionView().data());
+    }
+
+    TEST(Literals, OwnedCopiesSurviveMoves)
+    {
+        using Switch = yaclap::Switch<_TCHAR>;
+        using sv = std::basic_string_view<_TCHAR>;
+
+        // short names are stored in the small string buffer, which moves with the object
+        std::basic_string<_TCHAR> name{_T("-s")};
+        Switch a{name, _T("desc.")};
+        name[1] = _T('x');
+        EXPECT_EQ(sv{_T("-s")}, a.NameAliasBegin()->GetName());
+
+        Switch b{std::move(a)};
+        EXPECT_EQ(sv{_T("-s")}, b.NameAliasBegin()->GetName());
+        EXPECT_EQ(sv{_T("desc.")}, b.GetDescription());
+
+        Switch c;
+        c = b;
+        b = Switch{_T("-t"), _T("other")};
+        EXPECT_EQ(sv{_T("-s")}, c.NameAliasBegin()->GetName());
+        EXPECT_EQ(sv{_T("-t")}, b.NameAliasBegin()->GetName());
+        EXPECT_TRUE(c.IsMatch(sv{_T("-s")}));
+    }
+
+    TEST(Literals, LiteralOperator)
+    {
+        using namespace yaclap::literals;
+
+        constexpr yaclap::Literal<char> name = "--name"_lit;
+        static_assert(name.GetView().size() == 6, "literal length");
+        constexpr yaclap::Literal<wchar_t> wname = L"--name"_lit;
+        static_assert(wname.GetView().size() == 6, "literal length");
+
+        yaclap::Switch<char> sw{"--name"_lit, "desc."_lit};
+        sw.AddAlias("-n"_lit);
+        EXPECT_TRUE(sw.IsMatch(std::string_view{"-n"}));
+        EXPECT_EQ(std::string{"--name, -n"}, sw.GetAllNames());
+    }
+
+} // namespace yaclap_test
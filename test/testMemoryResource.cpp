@@ -0,0 +1,135 @@
+#include "yaclap.hpp"
+
+#ifdef _WIN32
+#include <tchar.h>
+#else
+#define _TCHAR char
+#define _T(A) A
+#endif
+
+#include <gtest/gtest.h>
+
+#include <memory_resource>
+#include <vector>
+
+namespace yaclap_test
+{
+
+    namespace
+    {
+        class CountingResource : public std::pmr::memory_resource
+        {
+        public:
+            size_t allocations = 0;
+            size_t deallocations = 0;
+
+        private:
+            void* do_allocate(size_t bytes, size_t alignment) override
+            {
+                allocations++;
+                return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+            }
+
+            void do_deallocate(void* p, size_t bytes, size_t alignment) override
+            {
+                deallocations++;
+                std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+            }
+
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+            {
+                return this == &other;
+            }
+        };
+    } // namespace
+
+    TEST(MemoryResource, ParseAllocatesFromResource)
+    {
+        using Parser = yaclap::Parser<_TCHAR>;
+        using Command = yaclap::Command<_TCHAR>;
+        using Option = yaclap::Option<_TCHAR>;
+        using Argument = yaclap::Argument<_TCHAR>;
+
+        Parser parser{_T("yaclap.exe"), _T("desc.")};
+        Argument arg{_T("a"), _T("desc.")};
+        Option opt{_T("-o"), _T("o"), _T("desc.")};
+        Command cmd{_T("cmd"), _T("desc.")};
+        cmd.Add(arg);
+        parser.Add(opt).Add(cmd);
+
+        CountingResource counter;
+        {
+            const _TCHAR* const argv[] = {_T("yaclap.exe"), _T("cmd"), _T("-o"), _T("2"), _T("1")};
+            Parser::Result res = parser.Parse(sizeof(argv) / sizeof(_TCHAR*), argv, true, &counter);
+
+            EXPECT_TRUE(res.IsSuccess());
+            EXPECT_TRUE(res.HasCommand(cmd));
+            EXPECT_EQ(std::basic_string_view<_TCHAR>(_T("2")), res.GetOptionValue(opt));
+            EXPECT_EQ(std::basic_string_view<_TCHAR>(_T("1")), res.GetArgument(arg));
+            EXPECT_LT(0, counter.allocations);
+
+            // the entries are stored in the pmr vectors
+            const std::pmr::vector<Parser::ResultValueView>& options = res.PmrOptions();
+            ASSERT_EQ(1, options.size());
+            EXPECT_EQ(std::basic_string_view<_TCHAR>(_T("2")), options[0]);
+            EXPECT_EQ(static_cast<std::pmr::memory_resource*>(&counter), options.get_allocator().resource());
+            EXPECT_EQ(1, res.PmrCommands().size());
+            EXPECT_EQ(1, res.PmrMatchedArguments().size());
+            EXPECT_TRUE(res.Options().empty());
+        }
+        EXPECT_EQ(counter.allocations, counter.deallocations);
+    }
+
+    TEST(MemoryResource, DefaultParseUsesStdVectors)
+    {
+        using Parser = yaclap::Parser<_TCHAR>;
+        using Command = yaclap::Command<_TCHAR>;
+        using Option = yaclap::Option<_TCHAR>;
+        using Switch = yaclap::Switch<_TCHAR>;
+
+        Parser parser{_T("yaclap.exe"), _T("desc.")};
+        Option opt{_T("-o"), _T("o"), _T("desc.")};
+        Switch swt{_T("-s"), _T("desc.")};
+        Command cmd{_T("cmd"), _T("desc.")};
+        parser.Add(opt).Add(swt).Add(cmd);
+
+        const _TCHAR* const argv[] = {_T("yaclap.exe"), _T("cmd"), _T("-o"), _T("2"), _T("-s"), _T("x")};
+        Parser::Result res = parser.Parse(sizeof(argv) / sizeof(_TCHAR*), argv);
+
+        const std::vector<yaclap::WithIdentity<_TCHAR>>& commands = res.Commands();
+        const std::vector<Parser::ResultValueView>& options = res.Options();
+        const std::vector<yaclap::WithIdentity<_TCHAR>>& switches = res.Switches();
+        const std::vector<Parser::ResultValueView>& unmatched = res.UnmatchedArguments();
+        EXPECT_EQ(1, commands.size());
+        ASSERT_EQ(1, options.size());
+        EXPECT_EQ(std::basic_string_view<_TCHAR>(_T("2")), options[0]);
+        EXPECT_EQ(1, switches.size());
+        EXPECT_EQ(1, unmatched.size());
+        EXPECT_TRUE(res.MatchedArguments().empty());
+        EXPECT_TRUE(res.PmrOptions().empty());
+    }
+
+    TEST(MemoryResource, MonotonicArena)
+    {
+        using Parser = yaclap::Parser<_TCHAR>;
+        using Option = yaclap::Option<_TCHAR>;
+
+        Parser parser{_T("yaclap.exe"), _T("desc.")};
+        Option opt{_T("-o"), _T("o"), _T("desc.")};
+        parser.Add(opt);
+
+        alignas(std::max_align_t) unsigned char buffer[4096];
+        for (int i = 0; i < 3; ++i)
+        {
+            // the arena must hold all memory of the parse, as its upstream refuses any allocation
+            std::pmr::monotonic_buffer_resource arena{buffer, sizeof(buffer), std::pmr::null_memory_resource()};
+
+            const _TCHAR* const argv[] = {_T("yaclap.exe"), _T("-o"), _T("1"), _T("-o=2")};
+            Parser::Result res = parser.Parse(sizeof(argv) / sizeof(_TCHAR*), argv, true, &arena);
+
+            EXPECT_TRUE(res.IsSuccess());
+            EXPECT_EQ(2, res.GetOptionCount(opt));
+        }
+    }
+
+} // namespace yaclap_test
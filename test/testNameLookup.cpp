@@ -0,0 +1,150 @@
+#include "yaclap.hpp"
+
+#ifdef _WIN32
+#include <tchar.h>
+#else
+#define _TCHAR char
+#define _T(A) A
+#endif
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+namespace yaclap_test
+{
+
+    TEST(NameLookup, CaseSensitivity)
+    {
+        using Parser = yaclap::Parser<_TCHAR>;
+        using StringCompare = yaclap::Alias<_TCHAR>::StringCompare;
+        using Switch = yaclap::Switch<_TCHAR>;
+
+        Parser parser{_T("yaclap.exe"), _T("desc.")};
+        Switch insensitive{{_T("--Verbose"), StringCompare::CaseInsensitive}, _T("desc.")};
+        Switch sensitive{_T("-Q"), _T("desc.")};
+        parser.Add(insensitive).Add(sensitive);
+        parser.SetErrorOnUnmatchedArguments(false);
+
+        const _TCHAR* const argv[] = {_T("yaclap.exe"), _T("--verbose"), _T("--VERBOSE"), _T("-Q"), _T("-q")};
+        Parser::Result res = parser.Parse(sizeof(argv) / sizeof(_TCHAR*), argv);
+
+        EXPECT_TRUE(res.IsSuccess());
+        EXPECT_EQ(2, res.HasSwitch(insensitive));
+        EXPECT_EQ(1, res.HasSwitch(sensitive));
+        ASSERT_EQ(1, res.UnmatchedArguments().size());
+        EXPECT_EQ(std::basic_string_view<_TCHAR>(_T("-q")), res.UnmatchedArguments()[0]);
+    }
+
+    TEST(NameLookup, LongCaseInsensitiveNames)
+    {
+        using Alias = yaclap::Alias<_TCHAR>;
+        using StringCompare = yaclap::Alias<_TCHAR>::StringCompare;
+        using sv = std::basic_string_view<_TCHAR>;
+
+        Alias alias{_T("--Some-Rather-Long-Option-Name_With.Digits-0123456789"), StringCompare::CaseInsensitive};
+
+        EXPECT_TRUE(alias.IsMatch(sv{_T("--some-rather-long-option-name_with.digits-0123456789")}));
+        EXPECT_TRUE(alias.IsMatch(sv{_T("--SOME-RATHER-LONG-OPTION-NAME_WITH.DIGITS-0123456789")}));
+        EXPECT_FALSE(alias.IsMatch(sv{_T("--some-rather-long-option-name_with.digits-0123456788")}));
+        EXPECT_FALSE(alias.IsMatch(sv{_T("--some-rather-long-option-name-with.digits-0123456789")}));
+        EXPECT_FALSE(alias.IsMatch(sv{_T("--some-rather-long-option-name_with.digits-012345678")}));
+
+        // '@' and '[' surround 'A'..'Z', and must not be folded
+        Alias edges{_T("@AZ[@az[@AZ[@az[@AZ["), StringCompare::CaseInsensitive};
+        EXPECT_TRUE(edges.IsMatch(sv{_T("@az[@AZ[@az[@AZ[@az[")}));
+        EXPECT_FALSE(edges.IsMatch(sv{_T("`az{@AZ[@az[@AZ[@az[")}));
+
+        Alias sensitive{_T("--Some-Rather-Long-Option-Name")};
+        EXPECT_TRUE(sensitive.IsMatch(sv{_T("--Some-Rather-Long-Option-Name")}));
+        EXPECT_FALSE(sensitive.IsMatch(sv{_T("--some-rather-long-option-name")}));
+    }
+
+    TEST(NameLookup, OptionValueSeparators)
+    {
+        using Parser = yaclap::Parser<_TCHAR>;
+        using StringCompare = yaclap::Alias<_TCHAR>::StringCompare;
+        using Option = yaclap::Option<_TCHAR>;
+
+        Parser parser{_T("yaclap.exe"), _T("desc.")};
+        Option opt{{_T("--input"), StringCompare::CaseInsensitive}, _T("file"), _T("desc.")};
+        opt.AddAlias(_T("-i"));
+        parser.Add(opt);
+
+        const _TCHAR* const argv[] = {_T("yaclap.exe"), _T("--INPUT=a"), _T("-i:b"), _T("-i c:d"), _T("-i"), _T("e=f")};
+        Parser::Result res = parser.Parse(sizeof(argv) / sizeof(_TCHAR*), argv);
+
+        EXPECT_TRUE(res.IsSuccess());
+        auto values = res.GetOptionValues(opt);
+        ASSERT_EQ(4, values.size());
+        EXPECT_EQ(std::basic_string_view<_TCHAR>(_T("a")), values[0]);
+        EXPECT_EQ(std::basic_string_view<_TCHAR>(_T("b")), values[1]);
+        EXPECT_EQ(std::basic_string_view<_TCHAR>(_T("c:d")), values[2]);
+        EXPECT_EQ(std::basic_string_view<_TCHAR>(_T("e=f")), values[3]);
+    }
+
+    TEST(NameLookup, CommandScopes)
+    {
+        using Parser = yaclap::Parser<_TCHAR>;
+        using Command = yaclap::Command<_TCHAR>;
+        using Option = yaclap::Option<_TCHAR>;
+        using Switch = yaclap::Switch<_TCHAR>;
+
+        Parser parser{_T("yaclap.exe"), _T("desc.")};
+        Switch rootSwitch{_T("-r"), _T("desc.")};
+        Option subOption{_T("-o"), _T("o"), _T("desc.")};
+        Command sub{_T("sub"), _T("desc.")};
+        sub.Add(subOption);
+        Command cmd{_T("cmd"), _T("desc.")};
+        cmd.Add(sub);
+        parser.Add(cmd).Add(rootSwitch);
+        parser.SetErrorOnUnmatchedArguments(false);
+
+        // `sub` and `-o` are only known in the scope of their parent commands
+        const _TCHAR* const argv1[] = {_T("yaclap.exe"), _T("sub"), _T("-o"), _T("1"), _T("-r")};
+        Parser::Result res = parser.Parse(sizeof(argv1) / sizeof(_TCHAR*), argv1);
+        EXPECT_TRUE(res.IsSuccess());
+        EXPECT_FALSE(res.HasCommand(sub));
+        EXPECT_FALSE(res.GetOptionValue(subOption));
+        EXPECT_EQ(1, res.HasSwitch(rootSwitch));
+        EXPECT_EQ(3, res.UnmatchedArguments().size());
+
+        const _TCHAR* const argv2[] = {_T("yaclap.exe"), _T("cmd"), _T("sub"), _T("-o"), _T("1"), _T("-r")};
+        res = parser.Parse(sizeof(argv2) / sizeof(_TCHAR*), argv2);
+        EXPECT_TRUE(res.IsSuccess());
+        EXPECT_TRUE(res.HasCommand(cmd));
+        EXPECT_TRUE(res.HasCommand(sub));
+        EXPECT_EQ(std::basic_string_view<_TCHAR>(_T("1")), res.GetOptionValue(subOption));
+        EXPECT_EQ(1, res.HasSwitch(rootSwitch));
+        EXPECT_EQ(0, res.UnmatchedArguments().size());
+    }
+
+    TEST(NameLookup, ManyOptions)
+    {
+        using Parser = yaclap::Parser<_TCHAR>;
+        using Option = yaclap::Option<_TCHAR>;
+
+        Parser parser{_T("yaclap.exe"), _T("desc.")};
+        std::vector<Option> options;
+        for (int i = 0; i < 500; ++i)
+        {
+            std::basic_string<_TCHAR> name{_T("--opt")};
+            for (_TCHAR c : std::to_string(i))
+            {
+                name += c;
+            }
+            options.emplace_back(yaclap::Alias<_TCHAR>{name}, _T("v"), _T("desc."));
+            parser.Add(options.back());
+        }
+
+        const _TCHAR* const argv[] = {_T("yaclap.exe"), _T("--opt0"), _T("a"), _T("--opt499=b"), _T("--opt250:c")};
+        Parser::Result res = parser.Parse(sizeof(argv) / sizeof(_TCHAR*), argv);
+
+        EXPECT_TRUE(res.IsSuccess());
+        EXPECT_EQ(std::basic_string_view<_TCHAR>(_T("a")), res.GetOptionValue(options[0]));
+        EXPECT_EQ(std::basic_string_view<_TCHAR>(_T("b")), res.GetOptionValue(options[499]));
+        EXPECT_EQ(std::basic_string_view<_TCHAR>(_T("c")), res.GetOptionValue(options[250]));
+        EXPECT_FALSE(res.GetOptionValue(options[1]));
+    }
+
+} // namespace yaclap_test
@@ -0,0 +1,129 @@
+#include "yaclap.hpp"
+
+#ifdef _WIN32
+#include <tchar.h>
+#else
+#define _TCHAR char
+#define _T(A) A
+#endif
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace yaclap_test
+{
+
+    namespace
+    {
+        class ResponseFileTest : public ::testing::Test
+        {
+        protected:
+            void SetUp() override
+            {
+                const ::testing::TestInfo* info = ::testing::UnitTest::GetInstance()->current_test_info();
+                m_dir = std::filesystem::temp_directory_path() / (std::string{"yaclap_test_"} + info->name());
+                std::filesystem::create_directories(m_dir);
+            }
+
+            void TearDown() override
+            {
+                std::error_code ec;
+                std::filesystem::remove_all(m_dir, ec);
+            }
+
+            /// <summary>
+            /// Writes the file and returns the argument `@path` referencing it
+            /// </summary>
+            std::basic_string<_TCHAR> Write(const char* name, const std::string& content)
+            {
+                const std::filesystem::path path = m_dir / name;
+                std::ofstream{path, std::ios::binary} << content;
+                return _T("@") + path.string<_TCHAR>();
+            }
+
+            std::filesystem::path m_dir;
+        };
+    } // namespace
+
+    TEST_F(ResponseFileTest, Expansion)
+    {
+        using Parser = yaclap::Parser<_TCHAR>;
+        using Option = yaclap::Option<_TCHAR>;
+        using Switch = yaclap::Switch<_TCHAR>;
+        using sv = std::basic_string_view<_TCHAR>;
+
+        Parser parser{_T("yaclap.exe"), _T("desc.")};
+        Option opt{_T("-o"), _T("o"), _T("desc.")};
+        Switch swt{_T("-s"), _T("desc.")};
+        parser.Add(opt).Add(swt);
+        parser.SetErrorOnUnmatchedArguments(false);
+        parser.EnableResponseFiles();
+
+        const std::basic_string<_TCHAR> inner = Write("inner.rsp", "-s\n-o \"with space\"\n");
+        const std::basic_string<_TCHAR> outer =
+            Write("outer.rsp", "\xEF\xBB\xBF-o plain -o 'single quoted' -o C:\\dir\\file\r\n@" +
+                                   (m_dir / "inner.rsp").string() + " -o esc\\\"aped\\ x -- @literal");
+
+        const _TCHAR* const argv[] = {_T("yaclap.exe"), outer.c_str(), _T("-s")};
+        Parser::Result res = parser.Parse(sizeof(argv) / sizeof(_TCHAR*), argv);
+
+        EXPECT_TRUE(res.IsSuccess()) << res.GetError();
+        EXPECT_EQ(1, res.HasSwitch(swt));
+        auto values = res.GetOptionValues(opt);
+        ASSERT_EQ(5, values.size());
+        EXPECT_EQ(sv{_T("plain")}, values[0]);
+        EXPECT_EQ(sv{_T("single quoted")}, values[1]);
+        EXPECT_EQ(sv{_T("C:\\dir\\file")}, values[2]);
+        EXPECT_EQ(sv{_T("with space")}, values[3]);
+        EXPECT_EQ(sv{_T("esc\"aped x")}, values[4]);
+        EXPECT_EQ(1, values[0].GetPosition());
+        // The stop token in the response file also applies to the following arguments of the command line
+        ASSERT_EQ(2, res.UnmatchedArguments().size());
+        EXPECT_EQ(sv{_T("@literal")}, res.UnmatchedArguments()[0]);
+        EXPECT_EQ(sv{_T("-s")}, res.UnmatchedArguments()[1]);
+
+        // Without enabling response files, `@file` is an ordinary argument
+        parser.EnableResponseFiles(false);
+        res = parser.Parse(sizeof(argv) / sizeof(_TCHAR*), argv);
+        EXPECT_EQ(1, res.HasSwitch(swt));
+        ASSERT_EQ(1, res.UnmatchedArguments().size());
+        EXPECT_EQ(sv{outer}, res.UnmatchedArguments()[0]);
+    }
+
+    TEST_F(ResponseFileTest, Errors)
+    {
+        using Parser = yaclap::Parser<_TCHAR>;
+
+        Parser parser{_T("yaclap.exe"), _T("desc.")};
+        parser.SetErrorOnUnmatchedArguments(false);
+        parser.EnableResponseFiles();
+
+        const std::basic_string<_TCHAR> missing = _T("@") + (m_dir / "missing.rsp").string<_TCHAR>();
+        const _TCHAR* const argv1[] = {_T("yaclap.exe"), missing.c_str()};
+        Parser::Result res = parser.Parse(sizeof(argv1) / sizeof(_TCHAR*), argv1);
+        EXPECT_FALSE(res.IsSuccess());
+        EXPECT_NE(std::basic_string<_TCHAR>::npos, res.GetError().find(_T("missing.rsp")));
+
+        const std::basic_string<_TCHAR> cycle = Write("a.rsp", "x @" + (m_dir / "b.rsp").string());
+        Write("b.rsp", "y @" + (m_dir / "." / "a.rsp").string());
+        const _TCHAR* const argv2[] = {_T("yaclap.exe"), cycle.c_str()};
+        res = parser.Parse(sizeof(argv2) / sizeof(_TCHAR*), argv2);
+        EXPECT_FALSE(res.IsSuccess());
+        EXPECT_NE(std::basic_string<_TCHAR>::npos, res.GetError().find(_T("a.rsp")));
+
+        const std::basic_string<_TCHAR> quote = Write("quote.rsp", "x \"unterminated");
+        const _TCHAR* const argv3[] = {_T("yaclap.exe"), quote.c_str()};
+        res = parser.Parse(sizeof(argv3) / sizeof(_TCHAR*), argv3);
+        EXPECT_FALSE(res.IsSuccess());
+
+        const std::basic_string<_TCHAR> empty = Write("empty.rsp", "");
+        const _TCHAR* const argv4[] = {_T("yaclap.exe"), empty.c_str()};
+        res = parser.Parse(sizeof(argv4) / sizeof(_TCHAR*), argv4);
+        EXPECT_TRUE(res.IsSuccess()) << res.GetError();
+        EXPECT_EQ(0, res.UnmatchedArguments().size());
+    }
+
+} // namespace yaclap_test
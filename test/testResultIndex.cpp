@@ -0,0 +1,78 @@
+#include "yaclap.hpp"
+
+#ifdef _WIN32
+#include <tchar.h>
+#else
+#define _TCHAR char
+#define _T(A) A
+#endif
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace yaclap_test
+{
+
+    TEST(ResultIndex, Queries)
+    {
+        using Parser = yaclap::Parser<_TCHAR>;
+        using Command = yaclap::Command<_TCHAR>;
+        using Option = yaclap::Option<_TCHAR>;
+        using Switch = yaclap::Switch<_TCHAR>;
+        using Argument = yaclap::Argument<_TCHAR>;
+
+        Parser parser{_T("yaclap.exe"), _T("desc.")};
+        Option optA{_T("-a"), _T("a"), _T("desc.")};
+        Option optB{_T("-b"), _T("b"), _T("desc.")};
+        Option optC{_T("-c"), _T("c"), _T("desc.")};
+        Switch swtX{_T("-x"), _T("desc.")};
+        Switch swtY{_T("-y"), _T("desc.")};
+        Argument arg1{_T("1"), _T("desc.")};
+        Argument arg2{_T("2"), _T("desc."), Argument::NotRequired};
+        Command cmd{_T("cmd"), _T("desc.")};
+        Command other{_T("other"), _T("desc.")};
+        cmd.Add(arg1).Add(arg2);
+        parser.Add(optA).Add(optB).Add(optC).Add(swtX).Add(swtY).Add(cmd).Add(other);
+
+        const _TCHAR* const argv[] = {_T("yaclap.exe"), _T("-a"), _T("a1"), _T("-b=b1"), _T("-x"), _T("cmd"),
+                                      _T("-a:a2"),      _T("-x"), _T("v1"), _T("-a"),    _T("a3")};
+        Parser::Result res = parser.Parse(sizeof(argv) / sizeof(_TCHAR*), argv);
+
+        EXPECT_TRUE(res.IsSuccess());
+        EXPECT_TRUE(res.HasCommand(cmd));
+        EXPECT_FALSE(res.HasCommand(other));
+
+        EXPECT_EQ(3, res.GetOptionCount(optA));
+        EXPECT_EQ(1, res.GetOptionCount(optB));
+        EXPECT_EQ(0, res.GetOptionCount(optC));
+
+        auto aValues = res.GetOptionValues(optA);
+        ASSERT_EQ(3, aValues.size());
+        EXPECT_EQ(std::basic_string_view<_TCHAR>(_T("a1")), aValues[0]);
+        EXPECT_EQ(std::basic_string_view<_TCHAR>(_T("a2")), aValues[1]);
+        EXPECT_EQ(std::basic_string_view<_TCHAR>(_T("a3")), aValues[2]);
+        EXPECT_EQ(2, aValues[0].GetPosition());
+        EXPECT_TRUE(res.GetOptionValues(optC).empty());
+
+        std::vector<Parser::ResultValueView> aVector = res.GetOptionValues(optA);
+        ASSERT_EQ(3, aVector.size());
+        EXPECT_EQ(std::basic_string_view<_TCHAR>(_T("a3")), aVector[2]);
+
+        EXPECT_EQ(std::basic_string_view<_TCHAR>(_T("a1")), res.GetOptionValue(optA));
+        EXPECT_EQ(std::basic_string_view<_TCHAR>(_T("b1")), res.GetOptionValue(optB));
+        EXPECT_FALSE(res.GetOptionValue(optC));
+
+        EXPECT_EQ(2, res.HasSwitch(swtX));
+        EXPECT_EQ(0, res.HasSwitch(swtY));
+
+        EXPECT_EQ(std::basic_string_view<_TCHAR>(_T("v1")), res.GetArgument(arg1));
+        EXPECT_FALSE(res.GetArgument(arg2));
+
+        EXPECT_EQ(std::basic_string_view<_TCHAR>(_T("b1")), res.GetOptionValue(optB, Parser::Result::ErrorIfMultiple));
+        EXPECT_TRUE(res.IsSuccess());
+        EXPECT_FALSE(res.GetOptionValue(optA, Parser::Result::ErrorIfMultiple));
+        EXPECT_FALSE(res.IsSuccess());
+    }
+
+} // namespace yaclap_test
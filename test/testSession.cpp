@@ -0,0 +1,123 @@
+#include "yaclap.hpp"
+
+#ifdef _WIN32
+#include <tchar.h>
+#else
+#define _TCHAR char
+#define _T(A) A
+#endif
+
+#include <gtest/gtest.h>
+
+#include <memory_resource>
+
+namespace yaclap_test
+{
+
+    namespace
+    {
+        class CountingResource : public std::pmr::memory_resource
+        {
+        public:
+            size_t allocations = 0;
+
+        private:
+            void* do_allocate(size_t bytes, size_t alignment) override
+            {
+                allocations++;
+                return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+            }
+
+            void do_deallocate(void* p, size_t bytes, size_t alignment) override
+            {
+                std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+            }
+
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+            {
+                return this == &other;
+            }
+        };
+    } // namespace
+
+    TEST(Session, RepeatedParse)
+    {
+        using Parser = yaclap::Parser<_TCHAR>;
+        using Command = yaclap::Command<_TCHAR>;
+        using Option = yaclap::Option<_TCHAR>;
+        using Switch = yaclap::Switch<_TCHAR>;
+        using Argument = yaclap::Argument<_TCHAR>;
+
+        Parser parser{_T("yaclap.exe"), _T("desc.")};
+        Argument arg{_T("a"), _T("desc.")};
+        Option opt{_T("-o"), _T("o"), _T("desc.")};
+        Switch swt{_T("-s"), _T("desc.")};
+        Command cmd{_T("cmd"), _T("desc.")};
+        cmd.Add(arg).Add(swt);
+        parser.Add(opt).Add(cmd);
+
+        Parser::Session session{parser};
+
+        const _TCHAR* const argv1[] = {_T("yaclap.exe"), _T("-o"), _T("1"), _T("cmd"), _T("-s"), _T("x")};
+        Parser::Result& res1 = session.Parse(sizeof(argv1) / sizeof(_TCHAR*), argv1);
+        EXPECT_TRUE(res1.IsSuccess());
+        EXPECT_TRUE(res1.HasCommand(cmd));
+        EXPECT_EQ(1, res1.HasSwitch(swt));
+        EXPECT_EQ(std::basic_string_view<_TCHAR>(_T("1")), res1.GetOptionValue(opt));
+        EXPECT_EQ(std::basic_string_view<_TCHAR>(_T("x")), res1.GetArgument(arg));
+
+        // The second parse starts from a clean Result, with no leftovers from the first one
+        const _TCHAR* const argv2[] = {_T("yaclap.exe"), _T("-s"), _T("y")};
+        Parser::Result& res2 = session.Parse(sizeof(argv2) / sizeof(_TCHAR*), argv2);
+        EXPECT_EQ(&res1, &res2);
+        EXPECT_FALSE(res2.IsSuccess());
+        EXPECT_FALSE(res2.HasCommand(cmd));
+        EXPECT_EQ(0, res2.HasSwitch(swt));
+        EXPECT_FALSE(res2.GetOptionValue(opt));
+        EXPECT_FALSE(res2.GetArgument(arg));
+        EXPECT_EQ(2, res2.UnmatchedArguments().size());
+
+        const _TCHAR* const argv3[] = {_T("yaclap.exe"), _T("cmd"), _T("z")};
+        Parser::Result& res3 = session.Parse(sizeof(argv3) / sizeof(_TCHAR*), argv3);
+        EXPECT_TRUE(res3.IsSuccess());
+        EXPECT_TRUE(res3.HasCommand(cmd));
+        EXPECT_EQ(std::basic_string_view<_TCHAR>(_T("z")), res3.GetArgument(arg));
+        EXPECT_EQ(0, res3.UnmatchedArguments().size());
+    }
+
+    TEST(Session, SteadyStateDoesNotAllocate)
+    {
+        using Parser = yaclap::Parser<_TCHAR>;
+        using Command = yaclap::Command<_TCHAR>;
+        using Option = yaclap::Option<_TCHAR>;
+        using Switch = yaclap::Switch<_TCHAR>;
+        using Argument = yaclap::Argument<_TCHAR>;
+
+        Parser parser{_T("yaclap.exe"), _T("desc.")};
+        Argument arg{_T("a"), _T("desc.")};
+        Option opt{_T("-o"), _T("o"), _T("desc.")};
+        Switch swt{_T("-s"), _T("desc.")};
+        Command cmd{_T("cmd"), _T("desc.")};
+        cmd.Add(arg).Add(swt);
+        parser.Add(opt).Add(cmd);
+
+        const _TCHAR* const argv[] = {_T("yaclap.exe"), _T("-o"), _T("1"), _T("cmd"), _T("-s"), _T("x"), _T("-o=2")};
+        const int argc = sizeof(argv) / sizeof(_TCHAR*);
+
+        CountingResource counter;
+        Parser::Session session{parser, &counter};
+        EXPECT_TRUE(session.Parse(argc, argv).IsSuccess());
+        EXPECT_TRUE(session.Parse(argc, argv).IsSuccess());
+        const size_t warm = counter.allocations;
+        EXPECT_LT(0, warm);
+
+        for (int i = 0; i < 100; ++i)
+        {
+            Parser::Result& res = session.Parse(argc, argv);
+            EXPECT_TRUE(res.IsSuccess());
+            EXPECT_EQ(2, res.GetOptionCount(opt));
+        }
+        EXPECT_EQ(warm, counter.allocations);
+    }
+
+} // namespace yaclap_test
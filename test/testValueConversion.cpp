@@ -0,0 +1,314 @@
+#include "yaclap.hpp"
+
+#ifdef _WIN32
+#include <tchar.h>
+#else
+#define _TCHAR char
+#define _T(A) A
+#endif
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace yaclap_test
+{
+
+    TEST(ValueConversion, ErrorReportedToResult)
+    {
+        using Parser = yaclap::Parser<_TCHAR>;
+        using Option = yaclap::Option<_TCHAR>;
+
+        Parser parser{_T("yaclap.exe"), _T("desc.")};
+        Option opt{_T("-o"), _T("o"), _T("desc.")};
+        parser.Add(opt);
+
+        const _TCHAR* const argv[] = {_T("yaclap.exe"), _T("-o"), _T("12x")};
+        Parser::Result res = parser.Parse(sizeof(argv) / sizeof(_TCHAR*), argv);
+        EXPECT_TRUE(res.IsSuccess());
+
+        Parser::ResultValueView value = res.GetOptionValue(opt);
+        EXPECT_FALSE(value.AsInteger().has_value());
+        EXPECT_FALSE(res.IsSuccess());
+        EXPECT_FALSE(res.GetError().empty());
+    }
+
+    TEST(ValueConversion, FirstErrorIsKept)
+    {
+        using Parser = yaclap::Parser<_TCHAR>;
+        using Option = yaclap::Option<_TCHAR>;
+
+        Parser parser{_T("yaclap.exe"), _T("desc.")};
+        Option optA{_T("-a"), _T("a"), _T("desc.")};
+        Option optB{_T("-b"), _T("b"), _T("desc.")};
+        parser.Add(optA).Add(optB);
+
+        const _TCHAR* const argv[] = {_T("yaclap.exe"), _T("-a"), _T("12x"), _T("-b"), _T("x")};
+        Parser::Result res = parser.Parse(sizeof(argv) / sizeof(_TCHAR*), argv);
+        EXPECT_TRUE(res.IsSuccess());
+
+        EXPECT_FALSE(res.GetOptionValue(optA).AsInteger().has_value());
+        const std::basic_string<_TCHAR> firstError = res.GetError();
+        EXPECT_FALSE(firstError.empty());
+
+        EXPECT_FALSE(res.GetOptionValue(optB).AsInteger().has_value());
+        EXPECT_FALSE(res.IsSuccess());
+        EXPECT_EQ(res.GetError(), firstError);
+    }
+
+    TEST(ValueConversion, MissingValueDoesNotReport)
+    {
+        using Parser = yaclap::Parser<_TCHAR>;
+        using Option = yaclap::Option<_TCHAR>;
+
+        Parser parser{_T("yaclap.exe"), _T("desc.")};
+        Option opt{_T("-o"), _T("o"), _T("desc.")};
+        parser.Add(opt);
+
+        const _TCHAR* const argv[] = {_T("yaclap.exe")};
+        Parser::Result res = parser.Parse(sizeof(argv) / sizeof(_TCHAR*), argv);
+
+        Parser::ResultValueView value = res.GetOptionValue(opt);
+        EXPECT_FALSE(value.HasValue());
+        EXPECT_FALSE(value.AsBool().has_value());
+        EXPECT_TRUE(res.IsSuccess());
+        EXPECT_TRUE(res.GetError().empty());
+    }
+
+    TEST(ValueConversion, Integers)
+    {
+        using Parser = yaclap::Parser<_TCHAR>;
+
+        Parser parser{_T("yaclap.exe"), _T("desc.")};
+        parser.SetErrorOnUnmatchedArguments(false);
+
+        const _TCHAR* const argv[] = {_T("yaclap.exe"),
+                                      _T(" 1234567890123 "),
+                                      _T("-9223372036854775808"),
+                                      _T("9223372036854775807"),
+                                      _T("9223372036854775808"),
+                                      _T("18446744073709551615"),
+                                      _T("18446744073709551616"),
+                                      _T("-x7fFFffFF"),
+                                      _T("o777"),
+                                      _T("B1010"),
+                                      _T("0000000000000000000000042"),
+                                      _T("-0"),
+                                      _T("x"),
+                                      _T("123456789o")};
+        Parser::Result res = parser.Parse(sizeof(argv) / sizeof(_TCHAR*), argv);
+        ASSERT_EQ(13, res.UnmatchedArguments().size());
+        auto const& v = res.UnmatchedArguments();
+
+        EXPECT_EQ(1234567890123ll, v[0].AsInteger());
+        EXPECT_FALSE(v[0].AsInt32(false).has_value());
+        EXPECT_EQ((std::numeric_limits<int64_t>::min)(), v[1].AsInt64());
+        EXPECT_EQ((std::numeric_limits<int64_t>::max)(), v[2].AsInt64());
+        EXPECT_FALSE(v[3].AsInt64(false).has_value());
+        EXPECT_EQ(9223372036854775808ull, v[3].AsUInt64());
+        EXPECT_EQ((std::numeric_limits<uint64_t>::max)(), v[4].AsUInt64());
+        EXPECT_FALSE(v[5].AsUInt64(false).has_value());
+        EXPECT_EQ(-0x7fffffff, v[6].AsInt32());
+        EXPECT_FALSE(v[6].AsUInt32(false).has_value());
+        EXPECT_EQ(0777u, v[7].AsUInt32());
+        EXPECT_EQ(10, v[8].AsInteger());
+        EXPECT_EQ(42, v[9].AsInt32());
+        EXPECT_EQ(0u, v[10].AsUInt32());
+        EXPECT_FALSE(v[11].AsInteger(false).has_value());
+        EXPECT_FALSE(v[12].AsInteger(false).has_value());
+
+        // conversions with errorWhenTypeParingFails = false do not report errors
+        EXPECT_TRUE(res.IsSuccess());
+
+        EXPECT_FALSE(v[12].AsInteger().has_value());
+        EXPECT_FALSE(res.IsSuccess());
+        EXPECT_NE(std::basic_string<_TCHAR>::npos, res.GetError().find(_T("position 10")));
+    }
+
+    TEST(ValueConversion, FloatingPoint)
+    {
+        using Parser = yaclap::Parser<_TCHAR>;
+
+        Parser parser{_T("yaclap.exe"), _T("desc.")};
+        parser.SetErrorOnUnmatchedArguments(false);
+
+        const _TCHAR* const argv[] = {_T("yaclap.exe"),
+                                      _T("0.1"),
+                                      _T("-.5"),
+                                      _T("5."),
+                                      _T("9007199254740993"),
+                                      _T("2.2250738585072014e-308"),
+                                      _T("1.7976931348623157E+308"),
+                                      _T("123456789012345678901234567890.123456789"),
+                                      _T("0.30000000000000004441"),
+                                      _T("1e-400"),
+                                      _T("1e309"),
+                                      _T("16777217"),
+                                      _T("1e"),
+                                      _T("."),
+                                      _T("1.5.")};
+        Parser::Result res = parser.Parse(sizeof(argv) / sizeof(_TCHAR*), argv);
+        ASSERT_EQ(14, res.UnmatchedArguments().size());
+        auto const& v = res.UnmatchedArguments();
+
+        EXPECT_EQ(0.1, v[0].AsDouble());
+        EXPECT_EQ(0.1f, v[0].AsFloat());
+        EXPECT_EQ(-0.5, v[1].AsDouble());
+        EXPECT_EQ(5.0, v[2].AsDouble());
+        EXPECT_EQ(9007199254740992.0, v[3].AsDouble());
+        EXPECT_EQ(2.2250738585072014e-308, v[4].AsDouble());
+        EXPECT_EQ(1.7976931348623157e308, v[5].AsDouble());
+        EXPECT_EQ(123456789012345678901234567890.123456789, v[6].AsDouble());
+        EXPECT_EQ(0.30000000000000004, v[7].AsDouble());
+        EXPECT_EQ(0.0, v[8].AsDouble());
+        EXPECT_FALSE(v[9].AsDouble(false).has_value());
+        EXPECT_FALSE(v[9].AsFloat(false).has_value());
+        EXPECT_EQ(16777216.0f, v[10].AsFloat());
+        EXPECT_EQ(16777217.0, v[10].AsDouble());
+        EXPECT_FALSE(v[11].AsDouble(false).has_value());
+        EXPECT_FALSE(v[12].AsDouble(false).has_value());
+        EXPECT_TRUE(res.IsSuccess());
+
+        EXPECT_FALSE(v[13].AsDouble().has_value());
+        EXPECT_FALSE(res.IsSuccess());
+        EXPECT_NE(std::basic_string<_TCHAR>::npos, res.GetError().find(_T("position 4")));
+    }
+
+    TEST(ValueConversion, ResultsAreCached)
+    {
+        using Parser = yaclap::Parser<_TCHAR>;
+        using Option = yaclap::Option<_TCHAR>;
+
+        Parser parser{_T("yaclap.exe"), _T("desc.")};
+        Option num{_T("-n"), _T("n"), _T("desc.")};
+        Option flag{_T("-f"), _T("f"), _T("desc.")};
+        parser.Add(num).Add(flag);
+
+        _TCHAR numText[] = _T("42");
+        _TCHAR flagText[] = _T("maybe");
+        const _TCHAR* const argv[] = {_T("yaclap.exe"), _T("-n"), numText, _T("-f"), flagText};
+        Parser::Session session{parser};
+        Parser::Result& res = session.Parse(sizeof(argv) / sizeof(_TCHAR*), argv);
+        EXPECT_TRUE(res.IsSuccess());
+
+        EXPECT_EQ(42, res.GetOptionValue(num).AsInteger());
+        EXPECT_EQ(42.0, res.GetOptionValue(num).AsDouble());
+
+        // conversions of the same value, also through other copies of the view, are looked up from the Result
+        numText[0] = _T('7');
+        EXPECT_EQ(42, res.GetOptionValue(num).AsInteger());
+        EXPECT_EQ(42u, res.GetOptionValue(num).AsUInt32());
+        EXPECT_EQ(42.0, res.GetOptionValue(num).AsDouble());
+        EXPECT_EQ(72.0f, res.GetOptionValue(num).AsFloat());
+
+        EXPECT_FALSE(res.GetOptionValue(flag).AsBool(false).has_value());
+        flagText[0] = _T('y');
+        flagText[1] = 0;
+        EXPECT_FALSE(res.GetOptionValue(flag).AsBool().has_value());
+        EXPECT_FALSE(res.IsSuccess());
+
+        // parsing again starts with an empty cache
+        Parser::Result& res2 = session.Parse(sizeof(argv) / sizeof(_TCHAR*), argv);
+        EXPECT_TRUE(res2.IsSuccess());
+        EXPECT_EQ(72, res2.GetOptionValue(num).AsInteger());
+        EXPECT_EQ(true, res2.GetOptionValue(flag).AsBool());
+    }
+
+    TEST(ValueConversion, Lists)
+    {
+        using Parser = yaclap::Parser<_TCHAR>;
+        using sv = std::basic_string_view<_TCHAR>;
+
+        Parser parser{_T("yaclap.exe"), _T("desc.")};
+        parser.SetErrorOnUnmatchedArguments(false);
+
+        std::basic_string<_TCHAR> ids;
+        for (int i = 0; i < 1000; ++i)
+        {
+            ids += (i == 0) ? _T("") : _T(",");
+            for (_TCHAR c : std::to_string(i * 7))
+            {
+                ids += c;
+            }
+        }
+        const _TCHAR* const argv[] = {_T("yaclap.exe"), ids.c_str(), _T("a;b;;c"), _T(""), _T("1.5, 2e3 ,-16"),
+                                      _T("1,2,three,4")};
+        Parser::Result res = parser.Parse(sizeof(argv) / sizeof(_TCHAR*), argv);
+        ASSERT_EQ(5, res.UnmatchedArguments().size());
+        auto const& v = res.UnmatchedArguments();
+
+        ASSERT_EQ(1000, v[0].Split().size());
+        std::vector<int32_t> values(1000);
+        EXPECT_EQ(1000, v[0].AsIntegerList(values.data(), values.size()));
+        for (int i = 0; i < 1000; ++i)
+        {
+            EXPECT_EQ(i * 7, values[i]);
+        }
+
+        std::vector<sv> elements{v[1].Split(_T(';')).begin(), v[1].Split(_T(';')).end()};
+        EXPECT_EQ((std::vector<sv>{sv{_T("a")}, sv{_T("b")}, sv{}, sv{_T("c")}}), elements);
+        EXPECT_EQ(4, v[1].Split(_T(';')).size());
+        EXPECT_TRUE(v[2].Split().empty());
+        EXPECT_EQ(0, v[2].Split().size());
+
+        double d[3];
+        EXPECT_EQ(3, v[3].AsDoubleList(d, 3));
+        EXPECT_EQ(1.5, d[0]);
+        EXPECT_EQ(2000.0, d[1]);
+        EXPECT_EQ(-16.0, d[2]);
+        EXPECT_FALSE(v[3].AsDoubleList(d, 2, _T(','), false).has_value());
+        EXPECT_TRUE(res.IsSuccess());
+
+        long long l[4];
+        EXPECT_FALSE(v[4].AsIntegerList(l, 4).has_value());
+        EXPECT_FALSE(res.IsSuccess());
+        EXPECT_NE(std::basic_string<_TCHAR>::npos, res.GetError().find(_T("list element 3")));
+    }
+
+    TEST(ValueConversion, RangeLists)
+    {
+        using Parser = yaclap::Parser<_TCHAR>;
+        using Interval = yaclap::RangeList::Interval;
+
+        Parser parser{_T("yaclap.exe"), _T("desc.")};
+        parser.SetErrorOnUnmatchedArguments(false);
+
+        const _TCHAR* const argv[] = {_T("yaclap.exe"), _T("32, 8-15,0-3,4,10-12"), _T("0-18446744073709551615"),
+                                      _T("x40-x7F"), _T("0-4096"), _T("5-2"), _T("1,-2")};
+        Parser::Result res = parser.Parse(sizeof(argv) / sizeof(_TCHAR*), argv);
+        ASSERT_EQ(6, res.UnmatchedArguments().size());
+        auto const& v = res.UnmatchedArguments();
+
+        auto cpus = v[0].AsRangeList(63);
+        ASSERT_TRUE(cpus.has_value());
+        EXPECT_EQ((std::vector<Interval>{{0, 4}, {8, 15}, {32, 32}}), cpus->Intervals());
+        EXPECT_EQ(14, cpus->Count());
+        EXPECT_TRUE(cpus->Contains(4));
+        EXPECT_FALSE(cpus->Contains(5));
+        EXPECT_TRUE(cpus->Contains(32));
+        EXPECT_EQ(0x10000FF1Full, cpus->ToBitset<64>().to_ullong());
+
+        auto all = v[1].AsRangeList();
+        ASSERT_TRUE(all.has_value());
+        EXPECT_EQ((std::numeric_limits<uint64_t>::max)(), all->Count());
+        uint64_t words[3]{};
+        all->ToBits(words, 3);
+        EXPECT_EQ(~uint64_t{0}, words[2]);
+
+        uint64_t hex[2]{};
+        v[2].AsRangeList()->ToBits(hex, 2);
+        EXPECT_EQ(0u, hex[0]);
+        EXPECT_EQ(~uint64_t{0}, hex[1]);
+
+        EXPECT_FALSE(v[3].AsRangeList(4095, _T(','), false).has_value());
+        EXPECT_FALSE(v[4].AsRangeList(4095, _T(','), false).has_value());
+        EXPECT_TRUE(res.IsSuccess());
+
+        EXPECT_FALSE(v[5].AsRangeList().has_value());
+        EXPECT_FALSE(res.IsSuccess());
+        EXPECT_NE(std::basic_string<_TCHAR>::npos, res.GetError().find(_T("list element 2")));
+    }
+
+} // namespace yaclap_test